@@ -80,6 +80,38 @@
 # error missing CC detection
 #endif
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                               SIMD DETECTION                                 *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#if defined(ARCH_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define SIMD_SSE2
+#endif
+
+#if defined(__SSSE3__) || (defined(CC_MSVC) && defined(__AVX__))
+# define SIMD_SSSE3
+#endif
+
+#if defined(__SSE4_2__) || (defined(CC_MSVC) && defined(__AVX__))
+# define SIMD_SSE42
+#endif
+
+#if defined(__PCLMUL__) || (defined(CC_MSVC) && defined(__AVX__))
+# define SIMD_PCLMUL
+#endif
+
+#if defined(__AVX2__)
+# define SIMD_AVX2
+#endif
+
+#if defined(ARCH_ARM64)
+# define SIMD_NEON
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+# define SIMD_ARM_CRC32
+#endif
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                 BASIC TYPES                                  *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -228,6 +260,39 @@ typedef void *VoidPtr, *Object, *Handle, *PTR;
 #define Clamp(a, x, b) (((x) < (a)) ? (a) : (((x) > (b)) ? (b) : (x)))
 #define Abs(x)  Max((x), -(x))
 
+/* NOTE: the result of counting zeros is undefined for zero inputs. */
+#if defined(CC_MSVC)
+#include <intrin.h>
+static __forceinline U32 CountTrailingZeros32(U32 x) { unsigned long i; _BitScanForward(&i, x); return (U32)i; }
+static __forceinline U32 CountLeadingZeros32(U32 x) { unsigned long i; _BitScanReverse(&i, x); return (U32)(31 - i); }
+# if defined(ARCH_X64) || defined(ARCH_ARM64)
+static __forceinline U32 CountTrailingZeros64(U64 x) { unsigned long i; _BitScanForward64(&i, x); return (U32)i; }
+static __forceinline U32 CountLeadingZeros64(U64 x) { unsigned long i; _BitScanReverse64(&i, x); return (U32)(63 - i); }
+# else
+static __forceinline U32 CountTrailingZeros64(U64 x) { return (U32)x ? CountTrailingZeros32((U32)x) : 32 + CountTrailingZeros32((U32)(x >> 32)); }
+static __forceinline U32 CountLeadingZeros64(U64 x) { return (x >> 32) ? CountLeadingZeros32((U32)(x >> 32)) : 32 + CountLeadingZeros32((U32)x); }
+# endif
+static __forceinline U32 PopCount64(U64 x)
+{
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (U32)((x * 0x0101010101010101ULL) >> 56);
+}
+#define PopCount32(x) PopCount64((U32)(x))
+#define ByteSwap32(x) ((U32)_byteswap_ulong(x))
+#define ByteSwap64(x) ((U64)_byteswap_uint64(x))
+#else
+#define CountTrailingZeros32(x) ((U32)__builtin_ctz(x))
+#define CountTrailingZeros64(x) ((U32)__builtin_ctzll(x))
+#define CountLeadingZeros32(x) ((U32)__builtin_clz(x))
+#define CountLeadingZeros64(x) ((U32)__builtin_clzll(x))
+#define PopCount32(x) ((U32)__builtin_popcount(x))
+#define PopCount64(x) ((U32)__builtin_popcountll(x))
+#define ByteSwap32(x) ((U32)__builtin_bswap32(x))
+#define ByteSwap64(x) ((U64)__builtin_bswap64(x))
+#endif
+
 #ifdef __cplusplus
 #define c_linkage_begin extern "C" {
 #define c_linkage_end   }
@@ -46,10 +46,231 @@ typedef struct DS_Array(T)  \
 
 #define DS_ArrayAt(arr, i) (*((i) < (arr).size ? &(arr).data[i] : nullptr))
 
+#define DS_ArraySortSTR(arr) STR_Sort((arr).data, (arr).size)
+#define DS_ArraySortUSTR(arr) USTR_Sort((arr).data, (arr).size)
+
 #define X DS_ArrayDefine
 X_FOR_BASE_TYPES
 #undef X
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                   SORTING                                    *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Pattern-defeating quicksort ordered by less(a, b), a function or macro taking
+   two values: median of three (or of nine) pivots, insertion sort for short
+   ranges and for nearly sorted ones, a three-way partition when many values
+   equal the pivot and heapsort when the partitions keep coming out unbalanced.
+   It is not stable. */
+
+#define DS_SORT_INSERTION 24
+#define DS_SORT_NINTHER 128
+
+#define DS_Sort(T) Glue(DS_Sort_, T)
+
+#define DS_SortDefine(T, less)                                                                 \
+static inline void Glue(DS_Sort(T), _Swap)(T *a, T *b)                                         \
+{                                                                                              \
+  T t = *a;                                                                                    \
+  *a = *b;                                                                                     \
+  *b = t;                                                                                      \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _Sort3)(T *a, T *b, T *c)                                  \
+{                                                                                              \
+  if (less(*b, *a)) Glue(DS_Sort(T), _Swap)(a, b);                                             \
+  if (less(*c, *b)) Glue(DS_Sort(T), _Swap)(b, c);                                             \
+  if (less(*b, *a)) Glue(DS_Sort(T), _Swap)(a, b);                                             \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _Insertion)(T *items, UZ count)                            \
+{                                                                                              \
+  for (UZ i = 1; i < count; ++i)                                                               \
+  {                                                                                            \
+    T item = items[i];                                                                         \
+    UZ j = i;                                                                                  \
+    for (; j && less(item, items[j - 1]); --j) items[j] = items[j - 1];                        \
+    items[j] = item;                                                                           \
+  }                                                                                            \
+}                                                                                              \
+static inline bool Glue(DS_Sort(T), _PartialInsertion)(T *items, UZ count)                     \
+{                                                                                              \
+  UZ moves = 0;                                                                                \
+  for (UZ i = 1; i < count && moves <= 8; ++i)                                                 \
+  {                                                                                            \
+    T item = items[i];                                                                         \
+    UZ j = i;                                                                                  \
+    for (; j && less(item, items[j - 1]); --j) items[j] = items[j - 1];                        \
+    items[j] = item;                                                                           \
+    moves += i - j;                                                                            \
+  }                                                                                            \
+  return moves <= 8;                                                                           \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _SiftDown)(T *items, UZ count, UZ index)                   \
+{                                                                                              \
+  T item = items[index];                                                                       \
+  for (UZ child; (child = 2 * index + 1) < count; index = child)                               \
+  {                                                                                            \
+    if (child + 1 < count && less(items[child], items[child + 1])) child++;                    \
+    if (!less(item, items[child])) break;                                                      \
+    items[index] = items[child];                                                               \
+  }                                                                                            \
+  items[index] = item;                                                                         \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _HeapSort)(T *items, UZ count)                             \
+{                                                                                              \
+  for (UZ i = count / 2; i--;) Glue(DS_Sort(T), _SiftDown)(items, count, i);                   \
+  for (UZ i = count; i-- > 1;)                                                                 \
+  {                                                                                            \
+    Glue(DS_Sort(T), _Swap)(items, items + i);                                                 \
+    Glue(DS_Sort(T), _SiftDown)(items, i, 0);                                                  \
+  }                                                                                            \
+}                                                                                              \
+static inline UZ Glue(DS_Sort(T), _PartitionRight)(T *items, UZ count, bool *partitioned)      \
+{                                                                                              \
+  T pivot = items[0];                                                                          \
+  T *first = items, *last = items + count;                                                     \
+  while (less(*++first, pivot));                                                               \
+  if (first - 1 == items) while (first < last && !less(*--last, pivot));                       \
+  else while (!less(*--last, pivot));                                                          \
+  *partitioned = first >= last;                                                                \
+  while (first < last)                                                                         \
+  {                                                                                            \
+    Glue(DS_Sort(T), _Swap)(first, last);                                                      \
+    while (less(*++first, pivot));                                                             \
+    while (!less(*--last, pivot));                                                             \
+  }                                                                                            \
+  items[0] = first[-1];                                                                        \
+  first[-1] = pivot;                                                                           \
+  return (UZ)(first - 1 - items);                                                              \
+}                                                                                              \
+static inline UZ Glue(DS_Sort(T), _PartitionLeft)(T *items, UZ count)                          \
+{                                                                                              \
+  T pivot = items[0];                                                                          \
+  T *first = items, *last = items + count;                                                     \
+  while (less(pivot, *--last));                                                                \
+  if (last + 1 == items + count) while (first < last && !less(pivot, *++first));               \
+  else while (!less(pivot, *++first));                                                         \
+  while (first < last)                                                                         \
+  {                                                                                            \
+    Glue(DS_Sort(T), _Swap)(first, last);                                                      \
+    while (less(pivot, *--last));                                                              \
+    while (!less(pivot, *++first));                                                            \
+  }                                                                                            \
+  items[0] = *last;                                                                            \
+  *last = pivot;                                                                               \
+  return (UZ)(last - items);                                                                   \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _Shuffle)(T *items, UZ count)                              \
+{                                                                                              \
+  if (count < DS_SORT_INSERTION) return;                                                       \
+  UZ quarter = count / 4;                                                                      \
+  Glue(DS_Sort(T), _Swap)(items, items + quarter);                                             \
+  Glue(DS_Sort(T), _Swap)(items + count - 1, items + count - quarter);                         \
+  if (count <= DS_SORT_NINTHER) return;                                                        \
+  Glue(DS_Sort(T), _Swap)(items + 1, items + quarter + 1);                                     \
+  Glue(DS_Sort(T), _Swap)(items + 2, items + quarter + 2);                                     \
+  Glue(DS_Sort(T), _Swap)(items + count - 2, items + count - quarter - 1);                     \
+  Glue(DS_Sort(T), _Swap)(items + count - 3, items + count - quarter - 2);                     \
+}                                                                                              \
+static inline void Glue(DS_Sort(T), _Loop)(T *items, UZ count, U32 bad, bool leftmost)         \
+{                                                                                              \
+  while (count >= DS_SORT_INSERTION)                                                           \
+  {                                                                                            \
+    UZ half = count / 2;                                                                       \
+    if (count > DS_SORT_NINTHER)                                                               \
+    {                                                                                          \
+      Glue(DS_Sort(T), _Sort3)(items, items + half, items + count - 1);                        \
+      Glue(DS_Sort(T), _Sort3)(items + 1, items + half - 1, items + count - 2);                \
+      Glue(DS_Sort(T), _Sort3)(items + 2, items + half + 1, items + count - 3);                \
+      Glue(DS_Sort(T), _Sort3)(items + half - 1, items + half, items + half + 1);              \
+      Glue(DS_Sort(T), _Swap)(items, items + half);                                            \
+    }                                                                                          \
+    else                                                                                       \
+    {                                                                                          \
+      Glue(DS_Sort(T), _Sort3)(items + half, items, items + count - 1);                        \
+    }                                                                                          \
+                                                                                               \
+    /* the value before the range is the pivot of an earlier partition, so a                   \
+       pivot equal to it is the least value: its copies go left and are done */                \
+    if (!leftmost && !less(items[-1], items[0]))                                               \
+    {                                                                                          \
+      UZ pivot = Glue(DS_Sort(T), _PartitionLeft)(items, count);                               \
+      items += pivot + 1;                                                                      \
+      count -= pivot + 1;                                                                      \
+      continue;                                                                                \
+    }                                                                                          \
+                                                                                               \
+    bool partitioned;                                                                          \
+    UZ pivot = Glue(DS_Sort(T), _PartitionRight)(items, count, &partitioned);                  \
+    UZ left = pivot, right = count - pivot - 1;                                                \
+    if (left < count / 8 || right < count / 8)                                                 \
+    {                                                                                          \
+      if (!--bad)                                                                              \
+      {                                                                                        \
+        Glue(DS_Sort(T), _HeapSort)(items, count);                                             \
+        return;                                                                                \
+      }                                                                                        \
+      Glue(DS_Sort(T), _Shuffle)(items, left);                                                 \
+      Glue(DS_Sort(T), _Shuffle)(items + pivot + 1, right);                                    \
+    }                                                                                          \
+    else if (partitioned && Glue(DS_Sort(T), _PartialInsertion)(items, left) &&                \
+             Glue(DS_Sort(T), _PartialInsertion)(items + pivot + 1, right))                    \
+    {                                                                                          \
+      return;                                                                                  \
+    }                                                                                          \
+                                                                                               \
+    /* recursing into the smaller side bounds the stack depth */                               \
+    if (left < right)                                                                          \
+    {                                                                                          \
+      Glue(DS_Sort(T), _Loop)(items, left, bad, leftmost);                                     \
+      items += pivot + 1;                                                                      \
+      count = right;                                                                           \
+      leftmost = false;                                                                        \
+    }                                                                                          \
+    else                                                                                       \
+    {                                                                                          \
+      Glue(DS_Sort(T), _Loop)(items + pivot + 1, right, bad, false);                           \
+      count = left;                                                                            \
+    }                                                                                          \
+  }                                                                                            \
+  Glue(DS_Sort(T), _Insertion)(items, count);                                                  \
+}                                                                                              \
+static inline void DS_Sort(T)(T *items, UZ count)                                              \
+{                                                                                              \
+  if (count > 1) Glue(DS_Sort(T), _Loop)(items, count, 64 - CountLeadingZeros64(count), true); \
+}
+
+#define DS_SortLess(a, b) ((a) < (b))
+
+#define X(T) DS_SortDefine(T, DS_SortLess)
+X(S8); X(S16); X(S32); X(S64); X(SZ);
+X(U8); X(U16); X(U32); X(U64); X(UZ);
+X(F32); X(F64);
+#undef X
+
+/* LSD radix sort for integer and floating point types with a buffer of the
+   same size, skipping the bytes that are the same in every value. The
+   parallel variant partitions on the highest byte that differs and sorts the
+   partitions on up to the given number of threads. Floating point values are
+   ordered by their bits, with negative NaNs first and positive NaNs last.
+   Both return false when the allocation fails, leaving the values unsorted. */
+
+#define DS_RADIX_UNSIGNED 0
+#define DS_RADIX_SIGNED 1
+#define DS_RADIX_FLOAT 2
+
+#define DS_RadixKind(T) ((T)0.5 != (T)0 ? DS_RADIX_FLOAT : (T)-1 < (T)1 ? DS_RADIX_SIGNED : DS_RADIX_UNSIGNED)
+
+bool __DS_RadixSort(MEM *mem, PTR items, UZ count, UZ size, U32 kind, U32 threads);
+
+#define DS_RadixSort(T, mem, items, count) __DS_RadixSort(mem, 1 ? (items) : (T*)0, count, sizeof(T), DS_RadixKind(T), 1)
+#define DS_RadixSortParallel(T, mem, items, count, threads) \
+  __DS_RadixSort(mem, 1 ? (items) : (T*)0, count, sizeof(T), DS_RadixKind(T), threads)
+
+#define DS_ArraySort(T, arr) DS_Sort(T)((arr).data, (arr).size)
+#define DS_ArrayRadixSort(T, mem, arr) DS_RadixSort(T, mem, (arr).data, (arr).size)
+#define DS_VectorSort(T, vec) DS_Sort(T)((vec)->data, (vec)->size)
+#define DS_VectorRadixSort(T, mem, vec) DS_RadixSort(T, mem, (vec)->data, (vec)->size)
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                    VECTOR                                    *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -66,26 +287,25 @@ typedef struct DS_Vector(T) \
 
 #define DS_VectorInit(T) ((DS_Vector(T)) { null })
 
-#define DS_VectorResize(mem, vec, sz) Statement(                        \
-  void *__data = (vec)->data;                                           \
-  UZ __cap = (vec)->capacity;                                           \
-  __cap = MEM_FastAlignDown(__cap, 8);                                  \
-  while ((sz) > __cap) __cap += 8;                                      \
-  if (__cap > (vec)->capacity)                                          \
-  {                                                                     \
-    __data = MEM_Reallocate(mem, __data, __cap * sizeof(*(vec)->data)); \
-    if (!__data) break; /* TODO: hadnle errors later! */                \
-  }                                                                     \
-  (vec)->data = __data;                                                 \
-  (vec)->size = (sz);                                                   \
-  (vec)->capacity = __cap;                                              \
-)
+/* Vectors grow geometrically, the functions below return false when the
+   allocation fails and leave the vector unchanged. */
 
-#define DS_VectorAppend(mem, vec, val) Statement(             \
-  UZ __size = (vec)->size + 1;                                \
-  DS_VectorResize(mem, vec, __size);                          \
-  if (__size == (vec)->size) (vec)->data[__size - 1] = (val); \
-)
+bool __DS_VectorReserve(MEM *mem, PTR vec, UZ element_size, UZ capacity);
+bool __DS_VectorGrow(MEM *mem, PTR vec, UZ element_size, UZ capacity);
+bool __DS_VectorShrinkToFit(MEM *mem, PTR vec, UZ element_size);
+bool __DS_VectorAppendArray(MEM *mem, PTR vec, UZ element_size, ConstPtr items, UZ count);
+
+#define DS_VectorReserve(mem, vec, cap) __DS_VectorReserve(mem, vec, sizeof(*(vec)->data), cap)
+#define DS_VectorShrinkToFit(mem, vec) __DS_VectorShrinkToFit(mem, vec, sizeof(*(vec)->data))
+
+#define DS_VectorResize(mem, vec, sz) \
+  (__DS_VectorGrow(mem, vec, sizeof(*(vec)->data), sz) ? ((vec)->size = (sz), true) : false)
+
+#define DS_VectorAppend(mem, vec, val) \
+  (__DS_VectorGrow(mem, vec, sizeof(*(vec)->data), (vec)->size + 1) ? ((vec)->data[(vec)->size++] = (val), true) : false)
+
+#define DS_VectorAppendArray(mem, vec, items, count) \
+  __DS_VectorAppendArray(mem, vec, sizeof(*(vec)->data), 1 ? (items) : (vec)->data, count)
 
 #define DS_VectorClear(mem, vec) Statement(           \
   if ((vec)->data) MEM_Deallocate(mem, (vec)->data);  \
@@ -116,26 +336,22 @@ typedef struct DS_Vector32(T) \
 
 #define DS_Vector32Init(T) ((DS_Vector32(T)) { null })
 
-#define DS_Vector32Resize(mem, vec, sz) Statement(                      \
-  void *__data = (vec)->data;                                           \
-  U32 __cap = (vec)->capacity;                                          \
-  __cap = MEM_FastAlignDown(__cap, 8);                                  \
-  while ((sz) > __cap) __cap += 8;                                      \
-  if (__cap > (vec)->capacity)                                          \
-  {                                                                     \
-    __data = MEM_Reallocate(mem, __data, __cap * sizeof(*(vec)->data)); \
-    if (!__data) break; /* TODO: hadnle errors later! */                \
-  }                                                                     \
-  (vec)->data = __data;                                                 \
-  (vec)->size = (sz);                                                   \
-  (vec)->capacity = __cap;                                              \
-)
+bool __DS_Vector32Reserve(MEM *mem, PTR vec, UZ element_size, UZ capacity);
+bool __DS_Vector32Grow(MEM *mem, PTR vec, UZ element_size, UZ capacity);
+bool __DS_Vector32ShrinkToFit(MEM *mem, PTR vec, UZ element_size);
+bool __DS_Vector32AppendArray(MEM *mem, PTR vec, UZ element_size, ConstPtr items, UZ count);
 
-#define DS_Vector32Append(mem, vec, val) Statement(           \
-  U32 __size = (vec)->size + 1;                               \
-  DS_VectorResize(mem, vec, __size);                          \
-  if (__size == (vec)->size) (vec)->data[__size - 1] = (val); \
-)
+#define DS_Vector32Reserve(mem, vec, cap) __DS_Vector32Reserve(mem, vec, sizeof(*(vec)->data), cap)
+#define DS_Vector32ShrinkToFit(mem, vec) __DS_Vector32ShrinkToFit(mem, vec, sizeof(*(vec)->data))
+
+#define DS_Vector32Resize(mem, vec, sz) \
+  (__DS_Vector32Grow(mem, vec, sizeof(*(vec)->data), sz) ? ((vec)->size = (U32)(sz), true) : false)
+
+#define DS_Vector32Append(mem, vec, val) \
+  (__DS_Vector32Grow(mem, vec, sizeof(*(vec)->data), (UZ)(vec)->size + 1) ? ((vec)->data[(vec)->size++] = (val), true) : false)
+
+#define DS_Vector32AppendArray(mem, vec, items, count) \
+  __DS_Vector32AppendArray(mem, vec, sizeof(*(vec)->data), 1 ? (items) : (vec)->data, count)
 
 #define DS_Vector32Clear(mem, vec) Statement(         \
   if ((vec)->data) MEM_Deallocate(mem, (vec)->data);  \
@@ -150,6 +366,126 @@ typedef struct DS_Vector32(T) \
 X_FOR_BASE_TYPES
 #undef X
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                 SMALL VECTOR                                 *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Holds up to N values in the struct itself and moves them to the heap when it
+   grows beyond that, heap stays null until then. */
+
+#define DS_SmallVector(T, N) Glue(DS_SmallVector_, Glue(T, Glue(_, N)))
+
+#define DS_SmallVectorDefine(T, N)  \
+typedef struct DS_SmallVector(T, N) \
+{                                   \
+  T *heap;                          \
+  UZ size;                          \
+  UZ capacity;                      \
+  T items[N];                       \
+} DS_SmallVector(T, N)
+
+bool __DS_SmallVectorReserve(MEM *mem, PTR vec, UZ element_size, ConstPtr items, UZ capacity);
+bool __DS_SmallVectorGrow(MEM *mem, PTR vec, UZ element_size, ConstPtr items, UZ capacity);
+bool __DS_SmallVectorShrinkToFit(MEM *mem, PTR vec, UZ element_size, PTR items, UZ inline_capacity);
+bool __DS_SmallVectorAppendArray(MEM *mem, PTR vec, UZ element_size, PTR items, ConstPtr values, UZ count);
+
+#define DS_SmallVectorInit(T, N) ((DS_SmallVector(T, N)) { .capacity = N })
+
+#define DS_SmallVectorData(vec) ((vec)->heap ? (vec)->heap : (vec)->items)
+#define DS_SmallVectorIsInline(vec) (!(vec)->heap)
+
+#define DS_SmallVectorReserve(mem, vec, cap) __DS_SmallVectorReserve(mem, vec, sizeof(*(vec)->items), (vec)->items, cap)
+#define DS_SmallVectorShrinkToFit(mem, vec) \
+  __DS_SmallVectorShrinkToFit(mem, vec, sizeof(*(vec)->items), (vec)->items, ArrayLength((vec)->items))
+
+#define DS_SmallVectorResize(mem, vec, sz) \
+  (__DS_SmallVectorGrow(mem, vec, sizeof(*(vec)->items), (vec)->items, sz) ? ((vec)->size = (sz), true) : false)
+
+#define DS_SmallVectorAppend(mem, vec, val) \
+  (__DS_SmallVectorGrow(mem, vec, sizeof(*(vec)->items), (vec)->items, (vec)->size + 1) ? (DS_SmallVectorData(vec)[(vec)->size++] = (val), true) : false)
+
+#define DS_SmallVectorAppendArray(mem, vec, values, count) \
+  __DS_SmallVectorAppendArray(mem, vec, sizeof(*(vec)->items), (vec)->items, 1 ? (values) : (vec)->items, count)
+
+#define DS_SmallVectorClear(mem, vec) Statement(      \
+  if ((vec)->heap) MEM_Deallocate(mem, (vec)->heap);  \
+  (vec)->heap = nullptr;                              \
+  (vec)->size = 0;                                    \
+  (vec)->capacity = ArrayLength((vec)->items);        \
+)
+
+#define DS_SmallVectorAt(vec, i) (*((i) < (vec)->size ? &DS_SmallVectorData(vec)[i] : nullptr))
+
+#define X(T) DS_SmallVectorDefine(T, 8)
+X_FOR_BASE_TYPES
+#undef X
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                     RING                                     *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Double-ended queue in a buffer with a power of two capacity, the values wrap
+   around from its end to its start. Value pointers are invalidated by pushes
+   and the pushed arrays must not point into the ring. */
+
+#define DS_Ring(T) Glue(DS_Ring_, T)
+
+#define DS_RingDefine(T)  \
+typedef struct DS_Ring(T) \
+{                         \
+  T *data;                \
+  UZ head;                \
+  UZ size;                \
+  UZ capacity;            \
+} DS_Ring(T)
+
+#define DS_RingInit(T) ((DS_Ring(T)) { null })
+
+bool __DS_RingReserve(MEM *mem, PTR ring, UZ element_size, UZ capacity);
+bool __DS_RingPushBackArray(MEM *mem, PTR ring, UZ element_size, ConstPtr items, UZ count);
+bool __DS_RingPushFrontArray(MEM *mem, PTR ring, UZ element_size, ConstPtr items, UZ count);
+UZ __DS_RingPopFrontArray(PTR ring, UZ element_size, PTR items, UZ count);
+UZ __DS_RingPopBackArray(PTR ring, UZ element_size, PTR items, UZ count);
+
+#define DS_RingMask(ring) ((ring)->capacity - 1)
+
+/* pushes return false when the allocation fails, pops return false when the ring is empty */
+#define DS_RingReserve(mem, ring, cap) __DS_RingReserve(mem, ring, sizeof(*(ring)->data), cap)
+
+#define DS_RingPushBack(mem, ring, val)                                 \
+  (__DS_RingReserve(mem, ring, sizeof(*(ring)->data), (ring)->size + 1) \
+    ? ((ring)->data[((ring)->head + (ring)->size++) & DS_RingMask(ring)] = (val), true) : false)
+
+#define DS_RingPushFront(mem, ring, val)                                \
+  (__DS_RingReserve(mem, ring, sizeof(*(ring)->data), (ring)->size + 1) \
+    ? ((ring)->head = ((ring)->head - 1) & DS_RingMask(ring), (ring)->size++, (ring)->data[(ring)->head] = (val), true) : false)
+
+#define DS_RingPopFront(ring, out) \
+  ((ring)->size ? (*(out) = (ring)->data[(ring)->head], (ring)->head = ((ring)->head + 1) & DS_RingMask(ring), (ring)->size--, true) : false)
+
+#define DS_RingPopBack(ring, out) \
+  ((ring)->size ? (*(out) = (ring)->data[((ring)->head + --(ring)->size) & DS_RingMask(ring)], true) : false)
+
+/* array pushes keep the order of the items, array pops return the number of
+   values popped in order and discard them when items is null */
+#define DS_RingPushBackArray(mem, ring, items, count) \
+  __DS_RingPushBackArray(mem, ring, sizeof(*(ring)->data), 1 ? (items) : (ring)->data, count)
+#define DS_RingPushFrontArray(mem, ring, items, count) \
+  __DS_RingPushFrontArray(mem, ring, sizeof(*(ring)->data), 1 ? (items) : (ring)->data, count)
+#define DS_RingPopFrontArray(ring, items, count) __DS_RingPopFrontArray(ring, sizeof(*(ring)->data), items, count)
+#define DS_RingPopBackArray(ring, items, count) __DS_RingPopBackArray(ring, sizeof(*(ring)->data), items, count)
+
+#define DS_RingClear(mem, ring) Statement(             \
+  if ((ring)->data) MEM_Deallocate(mem, (ring)->data); \
+  MemoryZeroStruct(ring);                              \
+)
+
+#define DS_RingAt(ring, i) (*((i) < (ring)->size ? &(ring)->data[((ring)->head + (i)) & DS_RingMask(ring)] : nullptr))
+
+#define X DS_RingDefine
+X_FOR_BASE_TYPES
+#undef X
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                 LINKED LIST                                  *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -168,11 +504,15 @@ typedef struct DS_ListNode(T) \
 X_FOR_BASE_TYPES
 #undef X
 
+/* The cursor remembers the last node found by index, so walking a list by
+   index moves one node per step instead of starting over. */
 typedef struct DS_List
 {
   PTR first;
   PTR last;
   UZ size;
+  PTR cursor;
+  UZ cursor_index;
 } DS_List;
 
 #define DS_ListInit() ((DS_List) { null })
@@ -190,6 +530,68 @@ void DS_ListPrependNode(DS_List *list, PTR node);
 
 #define DS_ListAt(T, l, i) (*((i) < (l)->size ? &((DS_ListNode(T)*)DS_ListGetNode(l, i))->value : nullptr))
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                UNROLLED LIST                                 *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Linked list of nodes holding as many values as fit in 128 bytes (at least
+   four), kept at least half full. Indexed access skips whole nodes, starting
+   from the first or last node or the last node found. Value pointers are
+   invalidated by inserts and removals. */
+
+#define DS_UNROLLED_NODE_SIZE 128
+
+typedef struct DS_UnrolledList
+{
+  PTR first;
+  PTR last;
+  UZ size;
+  PTR cursor;
+  UZ cursor_index;
+} DS_UnrolledList;
+
+PTR __DS_UnrolledListAt(DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index);
+PTR __DS_UnrolledListInsert(MEM *mem, DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index, ConstPtr value);
+bool __DS_UnrolledListRemove(MEM *mem, DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index);
+void DS_UnrolledListClear(MEM *mem, DS_UnrolledList *list);
+
+#define DS_UnrolledNode(T) Glue(DS_UnrolledNode_, T)
+#define DS_UnrolledCapacity(T) Max((UZ)4, (DS_UNROLLED_NODE_SIZE - 3 * sizeof(PTR)) / sizeof(T))
+
+/* the size of the values, their number per node and their offset in the node */
+#define DS_UnrolledLayout(T) sizeof(T), DS_UnrolledCapacity(T), MemberOffset(DS_UnrolledNode(T), values)
+
+#define DS_UnrolledNodeDefine(T)                                                                \
+typedef struct DS_UnrolledNode(T)                                                               \
+{                                                                                               \
+  PTR next;                                                                                     \
+  PTR prev;                                                                                     \
+  UZ count;                                                                                     \
+  T values[DS_UnrolledCapacity(T)];                                                             \
+} DS_UnrolledNode(T);                                                                           \
+static inline T *Glue(DS_UnrolledNode(T), _Insert)(MEM *mem, DS_UnrolledList *list, UZ index, T value) \
+{                                                                                               \
+  return __DS_UnrolledListInsert(mem, list, DS_UnrolledLayout(T), index, &value);               \
+}
+
+#define X DS_UnrolledNodeDefine
+X_FOR_BASE_TYPES
+#undef X
+
+#define DS_UnrolledListInit() ((DS_UnrolledList) { null })
+
+/* insert returns a pointer to the stored value or null when the allocation fails */
+#define DS_UnrolledListGet(T, l, i) ((T*)__DS_UnrolledListAt(l, DS_UnrolledLayout(T), i))
+#define DS_UnrolledListInsert(T, m, l, i, v) Glue(DS_UnrolledNode(T), _Insert)(m, l, i, v)
+#define DS_UnrolledListAppend(T, m, l, v) DS_UnrolledListInsert(T, m, l, (l)->size, v)
+#define DS_UnrolledListRemove(T, m, l, i) __DS_UnrolledListRemove(m, l, DS_UnrolledLayout(T), i)
+
+#define DS_UnrolledListAt(T, l, i) (*DS_UnrolledListGet(T, l, i))
+
+#define DS_UnrolledListForEach(T, V, l)                                       \
+for (DS_UnrolledNode(T) *__node = (l)->first; __node; __node = __node->next) \
+for (T *V = __node->values; V < __node->values + __node->count; ++V)
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                 BINARY TREE                                  *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -239,23 +641,624 @@ X_FOR_BASE_TYPES
 
 #define DS_TreeForEachChild(T, N, t) for (DS_Tree(T) *N = (t)->children.first; N; N = N->siblings[0])
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                   HASH MAP                                   *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Open addressing with a control byte per entry (7 bits of the hash, empty or
+   deleted) probed a group at a time. Keys are copied as values, so STR keys
+   must outlive the map, and floating point keys compare bitwise. Entry
+   pointers are invalidated by inserts. */
+
+typedef struct DS_HashKey
+{
+  UZ size;
+  U64 (*hash)(ConstPtr key);
+  bool (*equals)(ConstPtr left, ConstPtr right);
+} DS_HashKey;
+
+#define DS_HashKeyOf(K) Glue(DS_HASH_KEY_, K)
+
+#define X(K) extern const DS_HashKey DS_HashKeyOf(K)
+X_FOR_BASE_TYPES
+#undef X
+
+PTR __DS_HashMapFind(PTR map, const DS_HashKey *type, UZ entry_size, ConstPtr key);
+PTR __DS_HashMapInsert(PTR map, const DS_HashKey *type, UZ entry_size, ConstPtr key);
+bool __DS_HashMapRemove(PTR map, const DS_HashKey *type, UZ entry_size, ConstPtr key);
+bool __DS_HashMapReserve(PTR map, const DS_HashKey *type, UZ entry_size, UZ count);
+PTR __DS_HashMapNext(PTR map, UZ entry_size, PTR entry);
+
+void DS_HashMapClear(PTR map);
+void DS_HashMapFree(PTR map);
+
+#define DS_HashMap(K, V) Glue(DS_HashMap_, Glue(K, Glue(_, V)))
+#define DS_HashMapEntry(K, V) Glue(DS_HashMapEntry_, Glue(K, Glue(_, V)))
+
+#define DS_HashMapDefine(K, V)                                                                \
+typedef struct DS_HashMapEntry(K, V)                                                          \
+{                                                                                             \
+  K key;                                                                                      \
+  V value;                                                                                    \
+} DS_HashMapEntry(K, V);                                                                      \
+typedef struct DS_HashMap(K, V)                                                               \
+{                                                                                             \
+  MEM *mem;                                                                                   \
+  U8 *controls;                                                                               \
+  DS_HashMapEntry(K, V) *entries;                                                             \
+  UZ size;                                                                                    \
+  UZ capacity;                                                                                \
+  UZ growth;                                                                                  \
+} DS_HashMap(K, V);                                                                           \
+static inline V *Glue(DS_HashMap(K, V), _Find)(DS_HashMap(K, V) *map, K key)                  \
+{                                                                                             \
+  DS_HashMapEntry(K, V) *entry = __DS_HashMapFind(map, &DS_HashKeyOf(K), sizeof(*entry), &key);\
+  return entry ? &entry->value : nullptr;                                                     \
+}                                                                                             \
+static inline V *Glue(DS_HashMap(K, V), _Insert)(DS_HashMap(K, V) *map, K key, V value)       \
+{                                                                                             \
+  DS_HashMapEntry(K, V) *entry = __DS_HashMapInsert(map, &DS_HashKeyOf(K), sizeof(*entry), &key);\
+  if (!entry) return nullptr;                                                                 \
+  entry->value = value;                                                                       \
+  return &entry->value;                                                                       \
+}                                                                                             \
+static inline bool Glue(DS_HashMap(K, V), _Remove)(DS_HashMap(K, V) *map, K key)              \
+{                                                                                             \
+  return __DS_HashMapRemove(map, &DS_HashKeyOf(K), sizeof(DS_HashMapEntry(K, V)), &key);      \
+}                                                                                             \
+static inline bool Glue(DS_HashMap(K, V), _Reserve)(DS_HashMap(K, V) *map, UZ count)          \
+{                                                                                             \
+  return __DS_HashMapReserve(map, &DS_HashKeyOf(K), sizeof(DS_HashMapEntry(K, V)), count);    \
+}
+
+#define DS_HashMapInit(K, V, m) ((DS_HashMap(K, V)) { m })
+
+/* find and insert return a pointer to the value or null, insert overwrites the value of an existing key */
+#define DS_HashMapFind(K, V, map, key) Glue(DS_HashMap(K, V), _Find)(map, key)
+#define DS_HashMapInsert(K, V, map, key, value) Glue(DS_HashMap(K, V), _Insert)(map, key, value)
+#define DS_HashMapRemove(K, V, map, key) Glue(DS_HashMap(K, V), _Remove)(map, key)
+#define DS_HashMapReserve(K, V, map, count) Glue(DS_HashMap(K, V), _Reserve)(map, count)
+#define DS_HashMapContains(K, V, map, key) (DS_HashMapFind(K, V, map, key) != nullptr)
+
+#define DS_HashMapForEach(K, V, E, map) \
+for (DS_HashMapEntry(K, V) *E = __DS_HashMapNext(map, sizeof(*E), nullptr); E; E = __DS_HashMapNext(map, sizeof(*E), E))
+
+#define X(K) DS_HashMapDefine(K, PTR)
+X_FOR_BASE_TYPES
+#undef X
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                PRIORITY QUEUE                                *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* D-ary heap with the least value on top, ordered by less(a, b), a function or
+   macro taking two values. A push gives a handle that stays valid until its
+   value leaves the queue, for updating or removing that value. */
+
+#define DS_PRIORITY_QUEUE_ARITY 4
+
+#define DS_PriorityQueue(T) Glue(DS_PriorityQueue_, T)
+#define DS_PriorityEntry(T) Glue(DS_PriorityEntry_, T)
+
+#define DS_PriorityQueueDefine(T, less)                                                                                      \
+typedef struct DS_PriorityEntry(T)                                                                                           \
+{                                                                                                                            \
+  T value;                                                                                                                   \
+  UZ handle;                                                                                                                 \
+} DS_PriorityEntry(T);                                                                                                       \
+DS_VectorDefine(DS_PriorityEntry(T));                                                                                        \
+typedef struct DS_PriorityQueue(T)                                                                                           \
+{                                                                                                                            \
+  MEM *mem;                                                                                                                  \
+  DS_Vector(DS_PriorityEntry(T)) heap;                                                                                       \
+  DS_Vector(UZ) handles; /* heap index per handle, free handles link to the next */                                          \
+  UZ free;               /* first free handle plus one */                                                                    \
+} DS_PriorityQueue(T);                                                                                                       \
+static inline void Glue(DS_PriorityQueue(T), _Place)(DS_PriorityQueue(T) *queue, UZ index, DS_PriorityEntry(T) entry)        \
+{                                                                                                                            \
+  queue->heap.data[index] = entry;                                                                                           \
+  queue->handles.data[entry.handle] = index;                                                                                 \
+}                                                                                                                            \
+static inline void Glue(DS_PriorityQueue(T), _SiftUp)(DS_PriorityQueue(T) *queue, UZ index)                                  \
+{                                                                                                                            \
+  DS_PriorityEntry(T) entry = queue->heap.data[index];                                                                       \
+  while (index)                                                                                                              \
+  {                                                                                                                          \
+    UZ parent = (index - 1) / DS_PRIORITY_QUEUE_ARITY;                                                                       \
+    if (!less(entry.value, queue->heap.data[parent].value)) break;                                                           \
+    Glue(DS_PriorityQueue(T), _Place)(queue, index, queue->heap.data[parent]);                                               \
+    index = parent;                                                                                                          \
+  }                                                                                                                          \
+  Glue(DS_PriorityQueue(T), _Place)(queue, index, entry);                                                                    \
+}                                                                                                                            \
+static inline void Glue(DS_PriorityQueue(T), _SiftDown)(DS_PriorityQueue(T) *queue, UZ index)                                \
+{                                                                                                                            \
+  DS_PriorityEntry(T) entry = queue->heap.data[index];                                                                       \
+  for (UZ first; (first = index * DS_PRIORITY_QUEUE_ARITY + 1) < queue->heap.size;)                                          \
+  {                                                                                                                          \
+    UZ best = first, end = Min(first + DS_PRIORITY_QUEUE_ARITY, queue->heap.size);                                           \
+    for (UZ child = first + 1; child < end; ++child)                                                                         \
+    {                                                                                                                        \
+      if (less(queue->heap.data[child].value, queue->heap.data[best].value)) best = child;                                   \
+    }                                                                                                                        \
+    if (!less(queue->heap.data[best].value, entry.value)) break;                                                             \
+    Glue(DS_PriorityQueue(T), _Place)(queue, index, queue->heap.data[best]);                                                 \
+    index = best;                                                                                                            \
+  }                                                                                                                          \
+  Glue(DS_PriorityQueue(T), _Place)(queue, index, entry);                                                                    \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Contains)(DS_PriorityQueue(T) *queue, UZ handle)                               \
+{                                                                                                                            \
+  if (handle >= queue->handles.size) return false;                                                                           \
+  UZ index = queue->handles.data[handle];                                                                                    \
+  return index < queue->heap.size && queue->heap.data[index].handle == handle;                                               \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Reserve)(DS_PriorityQueue(T) *queue, UZ count)                                 \
+{                                                                                                                            \
+  if (count > MAX_UZ - queue->heap.size) return false;                                                                       \
+  return __DS_VectorGrow(queue->mem, &queue->heap, sizeof(*queue->heap.data), queue->heap.size + count) &&                   \
+         __DS_VectorGrow(queue->mem, &queue->handles, sizeof(UZ), queue->handles.size + count);                              \
+}                                                                                                                            \
+static inline void Glue(DS_PriorityQueue(T), _Add)(DS_PriorityQueue(T) *queue, T value, UZ *handle)                          \
+{                                                                                                                            \
+  UZ index = queue->heap.size++;                                                                                             \
+  if (queue->free)                                                                                                           \
+  {                                                                                                                          \
+    *handle = queue->free - 1;                                                                                               \
+    queue->free = queue->handles.data[*handle];                                                                              \
+  }                                                                                                                          \
+  else                                                                                                                       \
+  {                                                                                                                          \
+    *handle = queue->handles.size++;                                                                                         \
+  }                                                                                                                          \
+  queue->heap.data[index].value = value;                                                                                     \
+  queue->heap.data[index].handle = *handle;                                                                                  \
+  queue->handles.data[*handle] = index;                                                                                      \
+}                                                                                                                            \
+static inline void Glue(DS_PriorityQueue(T), _RemoveAt)(DS_PriorityQueue(T) *queue, UZ index)                                \
+{                                                                                                                            \
+  UZ handle = queue->heap.data[index].handle;                                                                                \
+  queue->handles.data[handle] = queue->free;                                                                                 \
+  queue->free = handle + 1;                                                                                                  \
+  DS_PriorityEntry(T) last = queue->heap.data[--queue->heap.size];                                                           \
+  if (index == queue->heap.size) return;                                                                                     \
+  bool up = index && less(last.value, queue->heap.data[(index - 1) / DS_PRIORITY_QUEUE_ARITY].value);                        \
+  Glue(DS_PriorityQueue(T), _Place)(queue, index, last);                                                                     \
+  if (up) Glue(DS_PriorityQueue(T), _SiftUp)(queue, index);                                                                  \
+  else Glue(DS_PriorityQueue(T), _SiftDown)(queue, index);                                                                   \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Push)(DS_PriorityQueue(T) *queue, T value, UZ *handle)                         \
+{                                                                                                                            \
+  UZ added;                                                                                                                  \
+  if (!Glue(DS_PriorityQueue(T), _Reserve)(queue, 1)) return false;                                                          \
+  Glue(DS_PriorityQueue(T), _Add)(queue, value, &added);                                                                     \
+  Glue(DS_PriorityQueue(T), _SiftUp)(queue, queue->heap.size - 1);                                                           \
+  if (handle) *handle = added;                                                                                               \
+  return true;                                                                                                               \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Pop)(DS_PriorityQueue(T) *queue, T *value)                                     \
+{                                                                                                                            \
+  if (!queue->heap.size) return false;                                                                                       \
+  if (value) *value = queue->heap.data[0].value;                                                                             \
+  Glue(DS_PriorityQueue(T), _RemoveAt)(queue, 0);                                                                            \
+  return true;                                                                                                               \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Remove)(DS_PriorityQueue(T) *queue, UZ handle, T *value)                       \
+{                                                                                                                            \
+  if (!Glue(DS_PriorityQueue(T), _Contains)(queue, handle)) return false;                                                    \
+  UZ index = queue->handles.data[handle];                                                                                    \
+  if (value) *value = queue->heap.data[index].value;                                                                         \
+  Glue(DS_PriorityQueue(T), _RemoveAt)(queue, index);                                                                        \
+  return true;                                                                                                               \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _Update)(DS_PriorityQueue(T) *queue, UZ handle, T value)                        \
+{                                                                                                                            \
+  if (!Glue(DS_PriorityQueue(T), _Contains)(queue, handle)) return false;                                                    \
+  UZ index = queue->handles.data[handle];                                                                                    \
+  bool up = less(value, queue->heap.data[index].value);                                                                      \
+  queue->heap.data[index].value = value;                                                                                     \
+  if (up) Glue(DS_PriorityQueue(T), _SiftUp)(queue, index);                                                                  \
+  else Glue(DS_PriorityQueue(T), _SiftDown)(queue, index);                                                                   \
+  return true;                                                                                                               \
+}                                                                                                                            \
+static inline bool Glue(DS_PriorityQueue(T), _PushArray)(DS_PriorityQueue(T) *queue, const T *values, UZ count, UZ *handles) \
+{                                                                                                                            \
+  UZ handle, size = queue->heap.size;                                                                                        \
+  if (!Glue(DS_PriorityQueue(T), _Reserve)(queue, count)) return false;                                                      \
+  for (UZ i = 0; i < count; ++i)                                                                                             \
+  {                                                                                                                          \
+    Glue(DS_PriorityQueue(T), _Add)(queue, values[i], handles ? &handles[i] : &handle);                                      \
+  }                                                                                                                          \
+  if (count < size)                                                                                                          \
+  {                                                                                                                          \
+    for (UZ i = size; i < queue->heap.size; ++i) Glue(DS_PriorityQueue(T), _SiftUp)(queue, i);                               \
+  }                                                                                                                          \
+  else                                                                                                                       \
+  {                                                                                                                          \
+    for (UZ i = queue->heap.size > 1 ? (queue->heap.size - 2) / DS_PRIORITY_QUEUE_ARITY + 1 : 0; i--;)                       \
+    {                                                                                                                        \
+      Glue(DS_PriorityQueue(T), _SiftDown)(queue, i);                                                                        \
+    }                                                                                                                        \
+  }                                                                                                                          \
+  return true;                                                                                                               \
+}
+
+#define DS_PriorityQueueInit(T, m) ((DS_PriorityQueue(T)) { m })
+
+/* push and push array return false when the allocation fails, the others when
+   the queue is empty or the handle is not in it, values can be null */
+#define DS_PriorityQueuePush(T, queue, value, handle) Glue(DS_PriorityQueue(T), _Push)(queue, value, handle)
+#define DS_PriorityQueuePop(T, queue, value) Glue(DS_PriorityQueue(T), _Pop)(queue, value)
+#define DS_PriorityQueueRemove(T, queue, handle, value) Glue(DS_PriorityQueue(T), _Remove)(queue, handle, value)
+#define DS_PriorityQueueUpdate(T, queue, handle, value) Glue(DS_PriorityQueue(T), _Update)(queue, handle, value)
+#define DS_PriorityQueueContains(T, queue, handle) Glue(DS_PriorityQueue(T), _Contains)(queue, handle)
+#define DS_PriorityQueueReserve(T, queue, count) Glue(DS_PriorityQueue(T), _Reserve)(queue, count)
+
+/* pushes many values at once, rebuilding the heap bottom-up when that is cheaper */
+#define DS_PriorityQueuePushArray(T, queue, values, count, handles) \
+  Glue(DS_PriorityQueue(T), _PushArray)(queue, values, count, handles)
+
+#define DS_PriorityQueueTop(queue) (*((queue)->heap.size ? &(queue)->heap.data[0].value : nullptr))
+
+#define DS_PriorityQueueClear(queue) Statement(     \
+  DS_VectorClear((queue)->mem, &(queue)->heap);     \
+  DS_VectorClear((queue)->mem, &(queue)->handles);  \
+  (queue)->free = 0;                                \
+)
+
+#define DS_PriorityLess(a, b) ((a) < (b))
+
+#define X(T) DS_PriorityQueueDefine(T, DS_PriorityLess)
+X(S32); X(S64); X(SZ);
+X(U32); X(U64); X(UZ);
+X(F32); X(F64);
+#undef X
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                    B-TREE                                    *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Ordered map keeping its entries in leaves of about 256 bytes linked in key
+   order, and separator keys in inner nodes of the same size. Each node is
+   searched with DS_BTreeSearch(K), which finds the first key not less than a
+   given one: it is predefined with SIMD for the integer keys and defined with
+   DS_BTreeSearchDefine for others. Inserts and removals invalidate cursors. */
+
+#define DS_BTREE_NODE_SIZE 256
+#define DS_BTREE_MAX_HEIGHT 32
+
+/* the nodes have room for one key over their capacity while being split */
+#define DS_BTreeLeafCapacity(K, V) (Max((UZ)5, (DS_BTREE_NODE_SIZE - 2 * sizeof(UZ)) / (sizeof(K) + sizeof(V))) - 1)
+#define DS_BTreeInnerCapacity(K) (Max((UZ)5, (DS_BTREE_NODE_SIZE - sizeof(UZ) - 2 * sizeof(PTR)) / (sizeof(K) + sizeof(PTR))) - 1)
+
+typedef struct DS_BTreeLayout
+{
+  UZ key_size;
+  UZ value_size;
+  UZ leaf_size;
+  UZ leaf_capacity;
+  UZ leaf_keys;
+  UZ leaf_values;
+  UZ inner_size;
+  UZ inner_capacity;
+  UZ inner_keys;
+  UZ inner_children;
+} DS_BTreeLayout;
+
+/* the node and the child or key index at each level of a search */
+typedef struct DS_BTreePath
+{
+  PTR nodes[DS_BTREE_MAX_HEIGHT];
+  UZ indices[DS_BTREE_MAX_HEIGHT];
+} DS_BTreePath;
+
+typedef struct DS_BTreeCursor
+{
+  PTR leaf;
+  UZ index;
+} DS_BTreeCursor;
+
+PTR __DS_BTreeInsert(PTR tree, const DS_BTreeLayout *layout, DS_BTreePath *path, ConstPtr key);
+void __DS_BTreeRemove(PTR tree, const DS_BTreeLayout *layout, DS_BTreePath *path);
+void __DS_BTreeClear(PTR tree, const DS_BTreeLayout *layout);
+
+#define DS_BTreeSearch(K) Glue(DS_BTreeSearch_, K)
+
+#define X(K) UZ DS_BTreeSearch(K)(const K *keys, UZ count, K key)
+X(S32); X(S64);
+X(U32); X(U64);
+#undef X
+
+static inline UZ DS_BTreeSearch_SZ(const SZ *keys, UZ count, SZ key)
+{
+  if (sizeof(SZ) == sizeof(S64)) return DS_BTreeSearch_S64((const S64*)keys, count, (S64)key);
+  return DS_BTreeSearch_S32((const S32*)keys, count, (S32)key);
+}
+
+static inline UZ DS_BTreeSearch_UZ(const UZ *keys, UZ count, UZ key)
+{
+  if (sizeof(UZ) == sizeof(U64)) return DS_BTreeSearch_U64((const U64*)keys, count, (U64)key);
+  return DS_BTreeSearch_U32((const U32*)keys, count, (U32)key);
+}
+
+/* binary search ordered by less(a, b), a function or macro taking two keys */
+#define DS_BTreeSearchDefine(K, less)                              \
+static inline UZ DS_BTreeSearch(K)(const K *keys, UZ count, K key) \
+{                                                                  \
+  UZ low = 0;                                                      \
+  while (count)                                                    \
+  {                                                                \
+    UZ half = count / 2;                                           \
+    if (less(keys[low + half], key))                               \
+    {                                                              \
+      low += half + 1;                                             \
+      count -= half + 1;                                           \
+    }                                                              \
+    else                                                           \
+    {                                                              \
+      count = half;                                                \
+    }                                                              \
+  }                                                                \
+  return low;                                                      \
+}
+
+#define DS_BTree(K, V) Glue(DS_BTree_, Glue(K, Glue(_, V)))
+#define DS_BTreeLeaf(K, V) Glue(DS_BTreeLeaf_, Glue(K, Glue(_, V)))
+#define DS_BTreeInner(K, V) Glue(DS_BTreeInner_, Glue(K, Glue(_, V)))
+
+#define DS_BTreeDefine(K, V, less)                                                                      \
+typedef struct DS_BTreeLeaf(K, V)                                                                       \
+{                                                                                                       \
+  UZ count;                                                                                             \
+  PTR next;                                                                                             \
+  K keys[DS_BTreeLeafCapacity(K, V) + 1];                                                               \
+  V values[DS_BTreeLeafCapacity(K, V) + 1];                                                             \
+} DS_BTreeLeaf(K, V);                                                                                   \
+typedef struct DS_BTreeInner(K, V)                                                                      \
+{                                                                                                       \
+  UZ count;                                                                                             \
+  K keys[DS_BTreeInnerCapacity(K) + 1];                                                                 \
+  PTR children[DS_BTreeInnerCapacity(K) + 2];                                                           \
+} DS_BTreeInner(K, V);                                                                                  \
+typedef struct DS_BTree(K, V)                                                                           \
+{                                                                                                       \
+  MEM *mem;                                                                                             \
+  PTR root;                                                                                             \
+  PTR first;                                                                                            \
+  UZ size;                                                                                              \
+  UZ height;                                                                                            \
+} DS_BTree(K, V);                                                                                       \
+static inline DS_BTreeLayout Glue(DS_BTree(K, V), _Layout)(void)                                        \
+{                                                                                                       \
+  return (DS_BTreeLayout) {                                                                             \
+    sizeof(K), sizeof(V),                                                                               \
+    sizeof(DS_BTreeLeaf(K, V)), DS_BTreeLeafCapacity(K, V),                                             \
+    offsetof(DS_BTreeLeaf(K, V), keys), offsetof(DS_BTreeLeaf(K, V), values),                           \
+    sizeof(DS_BTreeInner(K, V)), DS_BTreeInnerCapacity(K),                                              \
+    offsetof(DS_BTreeInner(K, V), keys), offsetof(DS_BTreeInner(K, V), children),                       \
+  };                                                                                                    \
+}                                                                                                       \
+static inline UZ Glue(DS_BTree(K, V), _Child)(DS_BTreeInner(K, V) *inner, K key)                        \
+{                                                                                                       \
+  UZ index = DS_BTreeSearch(K)(inner->keys, inner->count, key);                                         \
+  return index + (index < inner->count && !less(key, inner->keys[index]));                              \
+}                                                                                                       \
+static inline DS_BTreeLeaf(K, V) *Glue(DS_BTree(K, V), _Leaf)(DS_BTree(K, V) *tree, K key, UZ *index)   \
+{                                                                                                       \
+  PTR node = tree->root;                                                                                \
+  for (UZ level = 1; level < tree->height; ++level)                                                     \
+  {                                                                                                     \
+    DS_BTreeInner(K, V) *inner = node;                                                                  \
+    node = inner->children[Glue(DS_BTree(K, V), _Child)(inner, key)];                                   \
+  }                                                                                                     \
+  DS_BTreeLeaf(K, V) *leaf = node;                                                                      \
+  if (leaf) *index = DS_BTreeSearch(K)(leaf->keys, leaf->count, key);                                   \
+  return leaf;                                                                                          \
+}                                                                                                       \
+static inline bool Glue(DS_BTree(K, V), _Path)(DS_BTree(K, V) *tree, K key, DS_BTreePath *path)         \
+{                                                                                                       \
+  PTR node = tree->root;                                                                                \
+  UZ level = 0;                                                                                         \
+  for (; level + 1 < tree->height; ++level)                                                             \
+  {                                                                                                     \
+    DS_BTreeInner(K, V) *inner = node;                                                                  \
+    path->nodes[level] = node;                                                                          \
+    path->indices[level] = Glue(DS_BTree(K, V), _Child)(inner, key);                                    \
+    node = inner->children[path->indices[level]];                                                       \
+  }                                                                                                     \
+  if (!node) return false;                                                                              \
+  DS_BTreeLeaf(K, V) *leaf = node;                                                                      \
+  UZ index = DS_BTreeSearch(K)(leaf->keys, leaf->count, key);                                           \
+  path->nodes[level] = node;                                                                            \
+  path->indices[level] = index;                                                                         \
+  return index < leaf->count && !less(key, leaf->keys[index]);                                          \
+}                                                                                                       \
+static inline V *Glue(DS_BTree(K, V), _Find)(DS_BTree(K, V) *tree, K key)                               \
+{                                                                                                       \
+  UZ index;                                                                                             \
+  DS_BTreeLeaf(K, V) *leaf = Glue(DS_BTree(K, V), _Leaf)(tree, key, &index);                            \
+  return leaf && index < leaf->count && !less(key, leaf->keys[index]) ? &leaf->values[index] : nullptr; \
+}                                                                                                       \
+static inline V *Glue(DS_BTree(K, V), _Insert)(DS_BTree(K, V) *tree, K key, V value)                    \
+{                                                                                                       \
+  DS_BTreePath path;                                                                                    \
+  DS_BTreeLayout layout = Glue(DS_BTree(K, V), _Layout)();                                              \
+  V *slot;                                                                                              \
+  if (Glue(DS_BTree(K, V), _Path)(tree, key, &path))                                                    \
+  {                                                                                                     \
+    DS_BTreeLeaf(K, V) *leaf = path.nodes[tree->height - 1];                                            \
+    slot = &leaf->values[path.indices[tree->height - 1]];                                               \
+  }                                                                                                     \
+  else if (!(slot = __DS_BTreeInsert(tree, &layout, &path, &key)))                                      \
+  {                                                                                                     \
+    return nullptr;                                                                                     \
+  }                                                                                                     \
+  *slot = value;                                                                                        \
+  return slot;                                                                                          \
+}                                                                                                       \
+static inline bool Glue(DS_BTree(K, V), _Remove)(DS_BTree(K, V) *tree, K key)                           \
+{                                                                                                       \
+  DS_BTreePath path;                                                                                    \
+  DS_BTreeLayout layout = Glue(DS_BTree(K, V), _Layout)();                                              \
+  if (!Glue(DS_BTree(K, V), _Path)(tree, key, &path)) return false;                                     \
+  __DS_BTreeRemove(tree, &layout, &path);                                                               \
+  return true;                                                                                          \
+}                                                                                                       \
+static inline void Glue(DS_BTree(K, V), _Clear)(DS_BTree(K, V) *tree)                                   \
+{                                                                                                       \
+  DS_BTreeLayout layout = Glue(DS_BTree(K, V), _Layout)();                                              \
+  __DS_BTreeClear(tree, &layout);                                                                       \
+}                                                                                                       \
+static inline DS_BTreeCursor Glue(DS_BTree(K, V), _Next)(DS_BTreeCursor cursor)                         \
+{                                                                                                       \
+  DS_BTreeLeaf(K, V) *leaf = cursor.leaf;                                                               \
+  if (++cursor.index < leaf->count) return cursor;                                                      \
+  return (DS_BTreeCursor) { leaf->next, 0 };                                                            \
+}                                                                                                       \
+static inline DS_BTreeCursor Glue(DS_BTree(K, V), _LowerBound)(DS_BTree(K, V) *tree, K key)             \
+{                                                                                                       \
+  UZ index;                                                                                             \
+  DS_BTreeLeaf(K, V) *leaf = Glue(DS_BTree(K, V), _Leaf)(tree, key, &index);                            \
+  if (!leaf) return (DS_BTreeCursor) { null };                                                          \
+  if (index < leaf->count) return (DS_BTreeCursor) { leaf, index };                                     \
+  return (DS_BTreeCursor) { leaf->next, 0 };                                                            \
+}                                                                                                       \
+static inline bool Glue(DS_BTree(K, V), _Before)(DS_BTreeCursor cursor, K key)                          \
+{                                                                                                       \
+  return cursor.leaf && less(((DS_BTreeLeaf(K, V)*)cursor.leaf)->keys[cursor.index], key);              \
+}
+
+#define DS_BTreeInit(K, V, m) ((DS_BTree(K, V)) { m })
+
+/* find and insert return a pointer to the value or null, insert overwrites the value of an existing key */
+#define DS_BTreeFind(K, V, tree, key) Glue(DS_BTree(K, V), _Find)(tree, key)
+#define DS_BTreeInsert(K, V, tree, key, value) Glue(DS_BTree(K, V), _Insert)(tree, key, value)
+#define DS_BTreeRemove(K, V, tree, key) Glue(DS_BTree(K, V), _Remove)(tree, key)
+#define DS_BTreeContains(K, V, tree, key) (DS_BTreeFind(K, V, tree, key) != nullptr)
+#define DS_BTreeClear(K, V, tree) Glue(DS_BTree(K, V), _Clear)(tree)
+
+/* cursors point at an entry in key order, or have a null leaf past the last one */
+#define DS_BTreeFirst(tree) ((DS_BTreeCursor) { (tree)->first, 0 })
+#define DS_BTreeLowerBound(K, V, tree, key) Glue(DS_BTree(K, V), _LowerBound)(tree, key)
+#define DS_BTreeNext(K, V, cursor) Glue(DS_BTree(K, V), _Next)(cursor)
+#define DS_BTreeKey(K, V, cursor) (((DS_BTreeLeaf(K, V)*)(cursor).leaf)->keys[(cursor).index])
+#define DS_BTreeValue(K, V, cursor) (((DS_BTreeLeaf(K, V)*)(cursor).leaf)->values[(cursor).index])
+
+#define DS_BTreeForEach(K, V, C, tree) \
+for (DS_BTreeCursor C = DS_BTreeFirst(tree); C.leaf; C = DS_BTreeNext(K, V, C))
+
+/* iterates over the entries with keys from low up to but not including high */
+#define DS_BTreeForRange(K, V, C, tree, low, high)           \
+for (DS_BTreeCursor C = DS_BTreeLowerBound(K, V, tree, low); \
+     Glue(DS_BTree(K, V), _Before)(C, high); C = DS_BTreeNext(K, V, C))
+
+#define DS_BTreeLess(a, b) ((a) < (b))
+
+#define X(K) DS_BTreeDefine(K, PTR, DS_BTreeLess)
+X(S32); X(S64); X(SZ);
+X(U32); X(U64); X(UZ);
+#undef X
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                  BIT-FIELD                                   *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+/* Bits are stored in 64-bit words, the bits past the width are always clear. */
 typedef struct DS_BitField
 {
-  U8 *data;
+  U64 *data;
   UZ width;
 } DS_BitField;
 
+#define DS_BitFieldWords(width) (((width) + 63) >> 6)
+
 DS_BitField DS_BitFieldAllocate(MEM *mem, UZ width);
+#define DS_BitFieldDeallocate(mem, bits) MEM_Deallocate(mem, (bits).data)
 
 bool DS_BitFieldGet(DS_BitField bits, UZ index);
 bool DS_BitFieldFlip(DS_BitField bits, UZ index);
 void DS_BitFieldSet(DS_BitField bits, UZ index);
 void DS_BitFieldClear(DS_BitField bits, UZ index);
 
+/* ranges are clamped to the width */
+void DS_BitFieldSetRange(DS_BitField bits, UZ begin, UZ end);
+void DS_BitFieldClearRange(DS_BitField bits, UZ begin, UZ end);
+
+UZ DS_BitFieldCount(DS_BitField bits);
+
+/* return the width if there is no such bit at or after the offset */
+UZ DS_BitFieldFindSet(DS_BitField bits, UZ offset);
+UZ DS_BitFieldFindClear(DS_BitField bits, UZ offset);
+
+/* combine the other field into the first one, the missing bits of a shorter field count as clear */
+void DS_BitFieldAnd(DS_BitField bits, DS_BitField other);
+void DS_BitFieldOr(DS_BitField bits, DS_BitField other);
+void DS_BitFieldXor(DS_BitField bits, DS_BitField other);
+void DS_BitFieldAndNot(DS_BitField bits, DS_BitField other);
+
 #define DS_BitFieldSetValue(bits, index, value) (value ? DS_BitFieldSet(bits, index) : DS_BitFieldClear(bits, index))
 
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                               ROARING BITMAP                                 *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Set of U32 split by the high 16 bits into containers holding the low bits
+   as a sorted array (up to 4096 values), a 65536-bit bitmap or sorted runs
+   of (start, length - 1) pairs. Runs are only made by DS_RoaringOptimize,
+   changing a run container turns it back into an array or a bitmap. */
+
+#define DS_ROARING_ARRAY_MAX 4096
+
+typedef enum DS_RoaringType
+{
+  DS_ROARING_ARRAY,
+  DS_ROARING_BITMAP,
+  DS_ROARING_RUN,
+} DS_RoaringType;
+
+typedef struct DS_RoaringContainer
+{
+  U16 *data;
+  U32 size;
+  U32 capacity;
+  U32 cardinality;
+  U16 key;
+  U8 type;
+} DS_RoaringContainer;
+
+/* a view borrows the containers of a serialized bitmap and cannot be changed */
+typedef struct DS_Roaring
+{
+  MEM *mem;
+  DS_RoaringContainer *containers;
+  U32 count;
+  U32 capacity;
+  bool view;
+} DS_Roaring;
+
+#define DS_RoaringInit(m) ((DS_Roaring) { m })
+void DS_RoaringFree(DS_Roaring *bitmap);
+
+/* add returns false when the allocation fails, remove returns true if the value was removed */
+bool DS_RoaringAdd(DS_Roaring *bitmap, U32 value);
+bool DS_RoaringRemove(DS_Roaring *bitmap, U32 value);
+bool DS_RoaringContains(const DS_Roaring *bitmap, U32 value);
+U64 DS_RoaringCount(const DS_Roaring *bitmap);
+
+/* converts the containers to runs where they are smaller that way */
+bool DS_RoaringOptimize(DS_Roaring *bitmap);
+
+/* write into an empty result, which is left empty on failure */
+bool DS_RoaringOr(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right);
+bool DS_RoaringAnd(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right);
+bool DS_RoaringAndNot(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right);
+
+/* The serialized layout is a header, a 16-byte descriptor per container and
+   the container data at 8-byte aligned offsets, in host byte order. A view
+   reads it in place, so the data must be 8-byte aligned and outlive it. */
+UZ DS_RoaringSerializedSize(const DS_Roaring *bitmap);
+UZ DS_RoaringSerialize(const DS_Roaring *bitmap, U8 *buffer, UZ capacity);
+bool DS_RoaringView(DS_Roaring *bitmap, STR data);
+
 #endif
@@ -27,6 +27,7 @@ typedef struct LEX
   UZ position;
   U32 line;
   U16 column;
+  STR_ByteSet keyword_bytes;
 } LEX;
 
 typedef U16 LEX_RuleCallback(LEX *lex, PTR data);
@@ -58,6 +58,7 @@ U64 OS_FileSize(OS_File file);
 
 UZ OS_FileRead(OS_File file, STR buffer);
 UZ OS_FileWrite(OS_File file, STR data);
+UZ OS_FileWriteVector(OS_File file, const STR *data, UZ count);
 
 bool OS_FileExists(STR path);
 bool OS_FileRename(STR src, STR dst);
@@ -39,4 +39,25 @@ PTR __ARC_Init(MEM *mem, UZ size);
 PTR ARC_Clone(PTR _arc);
 void ARC_Free(PTR _arc);
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                SHARED STRINGS                                *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Immutable view into a reference-counted buffer, clones and slices share the
+   buffer and RSTR_Mutate copies it only while it is shared. Like RC, the count
+   is not atomic. Empty strings have no buffer. */
+typedef struct RSTR
+{
+  PTR rc;
+  STR string;
+} RSTR;
+
+RSTR RSTR_From_STR(MEM *mem, STR string);
+RSTR RSTR_Clone(RSTR string);
+void RSTR_Free(RSTR *string);
+
+RSTR RSTR_Slice(RSTR string, UZ begin, UZ end);
+bool RSTR_IsUnique(RSTR string);
+U8 *RSTR_Mutate(RSTR *string);
+
 #endif
@@ -25,13 +25,69 @@ STR STR_Copy(MEM *mem, STR other);
 STR STR_Cat(MEM *mem, STR left, STR right);
 STR STR_Replace(MEM *mem, STR string, STR substring, STR replacement);
 
+typedef struct STR_ReplaceRule
+{
+  STR substring;
+  STR replacement;
+} STR_ReplaceRule;
+
+STR STR_ReplaceMany(MEM *mem, STR string, const STR_ReplaceRule *rules, UZ count);
+
 UZ STR_Count(STR string, STR substring);
+UZ STR_CountByte(STR string, U8 byte);
 UZ STR_FindFirst(STR string, STR substring, UZ offset);
 UZ STR_FindLast(STR string, STR substring, UZ offset);
 
+/* A set of bytes, kept both as a bitmap and as nibble tables for vectorised matching. */
+typedef struct STR_ByteSet
+{
+  U8 bits[32];
+  U8 nibbles[2][16];
+  U8 bytes[8];
+  U32 count;
+} STR_ByteSet;
+
+#define STR_ByteSetContains(set, byte) (((set)->bits[(U8)(byte) >> 3] >> ((U8)(byte) & 7)) & 1)
+
+STR_ByteSet STR_ByteSetMake(STR bytes);
+void STR_ByteSetAdd(STR_ByteSet *set, U8 byte);
+
+UZ STR_FindFirstOf(STR string, const STR_ByteSet *set, UZ offset);
+UZ STR_FindFirstNotOf(STR string, const STR_ByteSet *set, UZ offset);
+
+/* Returns a mask with bit i set if byte i of the first 64 bytes of the string is in the set. */
+U64 STR_ByteSetClassify(const STR_ByteSet *set, STR string);
+
+/* Iterates over the fields between delimiters without copying them. */
+typedef struct STR_Split
+{
+  STR string;
+  UZ position;
+  const STR_ByteSet *delimiters;
+  bool skip_empty;
+} STR_Split;
+
+#define STR_SplitMake(string, delimiters) ((STR_Split) { (string), 0, (delimiters), false })
+#define STR_TokenizeMake(string, delimiters) ((STR_Split) { (string), 0, (delimiters), true })
+
+STR STR_SplitNext(STR_Split *split);
+
+#define STR_SplitForEach(N, split) for (STR N = STR_SplitNext(split); N.str; N = STR_SplitNext(split))
+
 U32 STR_Hash(STR string);
 U64 STR_Hash64(STR string);
 bool STR_Equals(STR left, STR right);
+S32 STR_Compare(STR left, STR right);
+
+/* Case conversion and case-insensitive comparison only consider ASCII letters. */
+void STR_ToLowerInPlace(STR string);
+void STR_ToUpperInPlace(STR string);
+STR STR_ToLower(MEM *mem, STR string);
+STR STR_ToUpper(MEM *mem, STR string);
+
+bool STR_EqualsNoCase(STR left, STR right);
+U32 STR_HashNoCase(STR string);
+U64 STR_Hash64NoCase(STR string);
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                                UTF-16 STRINGS                                *
@@ -61,10 +117,20 @@ S32 UTF8_DecodeFirst(STR string);
 UZ UTF8_Encode(U8 *buffer, UZ capacity, S32 codepoint);
 UZ UTF8_GetLength(STR string);
 
+bool UTF8_Validate(STR string);
+UZ UTF8_GetValidSize(STR string);
+UZ UTF8_CountCodepoints(STR string);
+
+UZ UTF8_GetUTF16Size(STR string);
+UZ UTF8_ToUTF16(U16 *buffer, UZ capacity, STR string, UZ *consumed);
+
 S32 UTF16_DecodeFirst(STR16 string);
 UZ UTF16_Encode(U16 *buffer, UZ capacity, S32 codepoint);
 UZ UTF16_GetLength(STR16 string);
 
+UZ UTF16_GetUTF8Size(STR16 string);
+UZ UTF16_ToUTF8(U8 *buffer, UZ capacity, STR16 string, UZ *consumed);
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 *                             UMBRA STYLE STRINGS                              *
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -76,7 +142,7 @@ typedef struct USTR
   union { U64 u; U8 s[8]; U8 *p; } data;
 } USTR;
 
-#define USTR_At(st, i) (*((i) < (st).size ? ((i) < 4 ? &(st).prefix.s[i] : ((st).size < 12 ? &(st).data.s[i] : &(st).data.p[i])) : nullptr))
+#define USTR_At(st, i) (*((i) < (st).size ? ((i) < 4 ? &(st).prefix.s[i] : ((st).size < 12 ? &(st).data.s[(i) - 4] : &(st).data.p[(i) - 4])) : nullptr))
 
 USTR USTR_Init(STR string);
 
@@ -89,5 +155,202 @@ STR STR_From_USTR(MEM *mem, USTR string);
 U32 USTR_Hash(USTR string);
 U64 USTR_Hash64(USTR string);
 bool USTR_Equals(USTR left, USTR right);
+S32 USTR_Compare(USTR left, USTR right);
+
+void STR_Sort(STR *strings, UZ count);
+void USTR_Sort(USTR *strings, UZ count);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                              NUMBER CONVERSION                               *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#define STR_U64_MAX_SIZE  20
+#define STR_S64_MAX_SIZE  20
+/* shortest floats are positional below 1e21, so the longest are a sign and 21
+   digits for F32 and "-0.00000" followed by 17 digits for F64 */
+#define STR_F64_MAX_SIZE  25
+#define STR_F32_MAX_SIZE  22
+
+#define STR_PRECISION_SHORTEST MAX_U32
+
+UZ STR_ParseU64(STR string, U64 *value);
+UZ STR_ParseS64(STR string, S64 *value);
+
+UZ STR_FormatU64(U8 *buffer, UZ capacity, U64 value);
+UZ STR_FormatS64(U8 *buffer, UZ capacity, S64 value);
+
+STR STR_From_U64(MEM *mem, U64 value);
+STR STR_From_S64(MEM *mem, S64 value);
+
+UZ STR_ParseF64(STR string, F64 *value);
+UZ STR_ParseF32(STR string, F32 *value);
+
+UZ STR_FormatF64(U8 *buffer, UZ capacity, F64 value);
+UZ STR_FormatF32(U8 *buffer, UZ capacity, F32 value);
+UZ STR_FormatF64Fixed(U8 *buffer, UZ capacity, F64 value, U32 precision);
+
+STR STR_From_F64(MEM *mem, F64 value);
+STR STR_From_F32(MEM *mem, F32 value);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                               BINARY ENCODING                                *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* The standard alphabet is padded with '=', the URL-safe one is not. Decoding accepts both. */
+typedef enum STR_Base64
+{
+  STR_BASE64,
+  STR_BASE64_URL,
+} STR_Base64;
+
+UZ STR_Base64EncodedSize(UZ size, STR_Base64 alphabet);
+UZ STR_Base64DecodedSize(STR string);
+
+UZ STR_Base64Encode(U8 *buffer, UZ capacity, STR data, STR_Base64 alphabet);
+UZ STR_Base64Decode(U8 *buffer, UZ capacity, STR string, STR_Base64 alphabet);
+
+STR STR_To_Base64(MEM *mem, STR data, STR_Base64 alphabet);
+STR STR_From_Base64(MEM *mem, STR string, STR_Base64 alphabet);
+
+#define STR_HexEncodedSize(size) ((size) * 2)
+#define STR_HexDecodedSize(string) ((string).size / 2)
+
+UZ STR_HexEncode(U8 *buffer, UZ capacity, STR data);
+UZ STR_HexDecode(U8 *buffer, UZ capacity, STR string);
+
+STR STR_To_Hex(MEM *mem, STR data);
+STR STR_From_Hex(MEM *mem, STR string);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                  CHECKSUMS                                   *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Updates continue from a previous result, so STR_CRC32CUpdate(STR_CRC32C(a), b) is the CRC of a followed by b. */
+U32 STR_CRC32C(STR data);
+U32 STR_CRC32CUpdate(U32 crc, STR data);
+
+U32 STR_Adler32(STR data);
+U32 STR_Adler32Update(U32 adler, STR data);
+
+typedef struct STR_XXH64State
+{
+  U64 accumulators[4];
+  U64 size;
+  U64 seed;
+  U8 buffer[32];
+} STR_XXH64State;
+
+U64 STR_XXH64(STR data, U64 seed);
+
+STR_XXH64State STR_XXH64Init(U64 seed);
+void STR_XXH64Update(STR_XXH64State *state, STR data);
+U64 STR_XXH64Digest(const STR_XXH64State *state);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                  FORMATTING                                  *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+* Placeholders look like {[index][:[[fill]align][0][width][.precision][type]]}, where align is one of '<', '>'
+* and '^', and type is 'x' or 'X' (hex) or 'b' (binary) for integers and 'f' (fixed) for floats. Braces are
+* escaped by doubling them. Floats without a precision use the shortest representation, strings are truncated
+* to the precision and padded to the width in codepoints.
+*/
+
+#define STR_FORMAT_NO_ARG         MAX_U32
+#define STR_FORMAT_MAX_PRECISION  512
+
+typedef enum STR_ArgType
+{
+  STR_ARG_STR,
+  STR_ARG_U64,
+  STR_ARG_S64,
+  STR_ARG_F64,
+} STR_ArgType;
+
+typedef struct STR_Arg
+{
+  STR_ArgType type;
+  union { STR s; U64 u; S64 i; F64 f; } value;
+} STR_Arg;
+
+#define STR_ArgSTR(v) ((STR_Arg) { .type = STR_ARG_STR, .value.s = (v) })
+#define STR_ArgU64(v) ((STR_Arg) { .type = STR_ARG_U64, .value.u = (v) })
+#define STR_ArgS64(v) ((STR_Arg) { .type = STR_ARG_S64, .value.i = (v) })
+#define STR_ArgF64(v) ((STR_Arg) { .type = STR_ARG_F64, .value.f = (v) })
+
+/* Expands to an array of arguments followed by its length. */
+#define STR_Args(...) ((STR_Arg[]) { __VA_ARGS__ }), (sizeof((STR_Arg[]) { __VA_ARGS__ }) / sizeof(STR_Arg))
+
+typedef struct STR_FormatPiece
+{
+  STR literal;
+  U32 arg;
+  U32 width;
+  U32 precision;
+  U8 fill;
+  U8 align;
+  U8 type;
+  bool zero;
+} STR_FormatPiece;
+
+/* A parsed format string; its pieces point into the format string, which must outlive it. */
+typedef struct STR_Format
+{
+  STR_FormatPiece *pieces;
+  U32 count;
+  U32 args;
+} STR_Format;
+
+STR_Format STR_FormatCompile(MEM *mem, STR format);
+void STR_FormatFree(MEM *mem, STR_Format *format);
+
+UZ STR_FormatSize(const STR_Format *format, const STR_Arg *args, UZ count);
+UZ STR_FormatWrite(U8 *buffer, UZ capacity, const STR_Format *format, const STR_Arg *args, UZ count);
+STR STR_From_Format(MEM *mem, const STR_Format *format, const STR_Arg *args, UZ count);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                               STRING BUILDER                                 *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#define STR_BUILDER_CHUNK_SIZE      KiB(4)
+#define STR_BUILDER_MAX_CHUNK_SIZE  MiB(1)
+
+typedef struct STR_BuilderChunk
+{
+  struct STR_BuilderChunk *next;
+  UZ size;
+  UZ capacity;
+} STR_BuilderChunk;
+
+#define STR_BuilderChunkData(chunk) ((U8*)((STR_BuilderChunk*)(chunk) + 1))
+
+typedef struct STR_Builder
+{
+  MEM *mem;
+  STR_BuilderChunk *first;
+  STR_BuilderChunk *last;
+  UZ size;
+  UZ count;
+} STR_Builder;
+
+#define STR_BuilderInit(mem) ((STR_Builder) { (mem) })
+void STR_BuilderFree(STR_Builder *builder);
+
+U8 *STR_BuilderReserve(STR_Builder *builder, UZ size);
+void STR_BuilderCommit(STR_Builder *builder, UZ size);
+
+bool STR_BuilderAppend(STR_Builder *builder, STR string);
+bool STR_BuilderAppendByte(STR_Builder *builder, U8 byte);
+bool STR_BuilderAppendU64(STR_Builder *builder, U64 value);
+bool STR_BuilderAppendS64(STR_Builder *builder, S64 value);
+bool STR_BuilderAppendF64(STR_Builder *builder, F64 value, U32 precision);
+bool STR_BuilderAppendReplaceMany(STR_Builder *builder, STR string, const STR_ReplaceRule *rules, UZ count);
+bool STR_BuilderAppendBase64(STR_Builder *builder, STR data, STR_Base64 alphabet);
+bool STR_BuilderAppendHex(STR_Builder *builder, STR data);
+bool STR_BuilderAppendFormat(STR_Builder *builder, const STR_Format *format, const STR_Arg *args, UZ count);
+
+UZ STR_BuilderGetSlices(STR_Builder *builder, STR *slices, UZ capacity);
+STR STR_From_Builder(MEM *mem, STR_Builder *builder);
 
 #endif
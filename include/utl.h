@@ -5,4 +5,76 @@
 
 STR UTL_LoadFile(MEM *mem, STR path);
 
+UZ UTL_WriteBuilder(OS_File file, STR_Builder *builder);
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                              STRING INTERNING                                *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+typedef U32 UTL_Atom;
+
+#define UTL_ATOM_NULL 0
+
+typedef struct UTL_InternEntry
+{
+  USTR string;
+  U8 *data;
+  U64 hash;
+} UTL_InternEntry;
+
+typedef struct UTL_InternTable
+{
+  MEM *mem;
+  MEM_Arena *arena;
+  UTL_InternEntry *entries;
+  UTL_Atom *slots;
+  U32 count;
+  U32 reserved;
+  U32 capacity;
+  OS_Mutex mutex;
+} UTL_InternTable;
+
+UTL_InternTable UTL_InternTableInit(MEM *mem, MEM_Arena *arena);
+UTL_InternTable UTL_InternTableInitAtomic(MEM *mem, MEM_Arena *arena);
+void UTL_InternTableFree(UTL_InternTable *table);
+
+UTL_Atom UTL_Intern(UTL_InternTable *table, STR string);
+UTL_Atom UTL_InternFind(UTL_InternTable *table, STR string);
+USTR UTL_InternUSTR(UTL_InternTable *table, STR string);
+
+USTR UTL_AtomToUSTR(UTL_InternTable *table, UTL_Atom atom);
+STR UTL_AtomToSTR(UTL_InternTable *table, UTL_Atom atom);
+
+/* interned USTR are equal only if all of their 16 bytes are equal */
+#define UTL_InternedEquals(l, r) ((l).size == (r).size && (l).prefix.u == (r).prefix.u && (l).data.u == (r).data.u)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*                                 LINE INDEX                                   *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* Lines and columns are 0-based, columns count bytes. */
+typedef struct UTL_LinePosition
+{
+  UZ line;
+  UZ column;
+} UTL_LinePosition;
+
+/* Line starts are stored as 32-bit offsets within 4 GiB segments, segments[k]
+   is the first line starting in segment k. */
+typedef struct UTL_LineIndex
+{
+  MEM *mem;
+  U32 *starts;
+  UZ *segments;
+  UZ count;
+  UZ segment_count;
+} UTL_LineIndex;
+
+/* splits the text between up to the given number of threads, 0 or 1 builds it on the calling thread */
+UTL_LineIndex UTL_LineIndexInit(MEM *mem, STR text, U32 threads);
+void UTL_LineIndexFree(UTL_LineIndex *index);
+
+UZ UTL_LineIndexStart(const UTL_LineIndex *index, UZ line);
+UTL_LinePosition UTL_LineIndexFind(const UTL_LineIndex *index, UZ offset);
+
 #endif
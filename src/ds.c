@@ -1,4 +1,297 @@
 #include <ds.h>
+#include <os.h>
+
+#if defined(ARCH_X64) || defined(ARCH_X86)
+#include <immintrin.h>
+#elif defined(SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+typedef struct __DS_Vector
+{
+  PTR data;
+  UZ size;
+  UZ capacity;
+} __DS_Vector;
+
+typedef struct __DS_Vector32
+{
+  PTR data;
+  U32 size;
+  U32 capacity;
+} __DS_Vector32;
+
+#define DS_VECTOR_MIN_CAPACITY 8
+
+/* Returns the capacity to grow to for a given size, doubling up to the limit. */
+static UZ DS_VectorGrowth(UZ capacity, UZ size, UZ limit)
+{
+  UZ grown = capacity < limit / 2 ? Max(capacity * 2, (UZ)DS_VECTOR_MIN_CAPACITY) : limit;
+  return Max(grown, size);
+}
+
+static PTR DS_VectorReallocate(MEM *mem, PTR data, UZ element_size, UZ capacity)
+{
+  if (capacity > MAX_UZ / element_size) return nullptr;
+  return MEM_Reallocate(mem, data, capacity * element_size);
+}
+
+/* Returns the copied items, moved along with the data if they are a part of it. */
+static ConstPtr DS_VectorItems(ConstPtr items, PTR old_data, PTR data, UZ size)
+{
+  UP offset = (UP)items - (UP)old_data;
+  return old_data && (UP)items >= (UP)old_data && offset < size ? (U8*)data + offset : items;
+}
+
+bool __DS_VectorReserve(MEM *mem, PTR _vec, UZ element_size, UZ capacity)
+{
+  __DS_Vector *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  PTR data = DS_VectorReallocate(mem, vec->data, element_size, capacity);
+  if (!data) return false;
+  vec->data = data;
+  vec->capacity = capacity;
+  return true;
+}
+
+bool __DS_VectorGrow(MEM *mem, PTR _vec, UZ element_size, UZ capacity)
+{
+  __DS_Vector *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  return __DS_VectorReserve(mem, vec, element_size, DS_VectorGrowth(vec->capacity, capacity, MAX_UZ / element_size));
+}
+
+bool __DS_VectorShrinkToFit(MEM *mem, PTR _vec, UZ element_size)
+{
+  __DS_Vector *vec = _vec;
+  if (vec->size == vec->capacity) return true;
+  if (!vec->size)
+  {
+    MEM_Deallocate(mem, vec->data);
+    vec->data = nullptr;
+    vec->capacity = 0;
+    return true;
+  }
+  PTR data = DS_VectorReallocate(mem, vec->data, element_size, vec->size);
+  if (!data) return false;
+  vec->data = data;
+  vec->capacity = vec->size;
+  return true;
+}
+
+bool __DS_VectorAppendArray(MEM *mem, PTR _vec, UZ element_size, ConstPtr items, UZ count)
+{
+  __DS_Vector *vec = _vec;
+  PTR old_data = vec->data;
+  if (count > MAX_UZ - vec->size || !__DS_VectorGrow(mem, vec, element_size, vec->size + count)) return false;
+  items = DS_VectorItems(items, old_data, vec->data, vec->size * element_size);
+  MemoryCopy((U8*)vec->data + vec->size * element_size, items, count * element_size);
+  vec->size += count;
+  return true;
+}
+
+bool __DS_Vector32Reserve(MEM *mem, PTR _vec, UZ element_size, UZ capacity)
+{
+  __DS_Vector32 *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  PTR data = capacity <= MAX_U32 ? DS_VectorReallocate(mem, vec->data, element_size, capacity) : nullptr;
+  if (!data) return false;
+  vec->data = data;
+  vec->capacity = (U32)capacity;
+  return true;
+}
+
+bool __DS_Vector32Grow(MEM *mem, PTR _vec, UZ element_size, UZ capacity)
+{
+  __DS_Vector32 *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  return __DS_Vector32Reserve(mem, vec, element_size, DS_VectorGrowth(vec->capacity, capacity, Min((UZ)MAX_U32, MAX_UZ / element_size)));
+}
+
+bool __DS_Vector32ShrinkToFit(MEM *mem, PTR _vec, UZ element_size)
+{
+  __DS_Vector32 *vec = _vec;
+  if (vec->size == vec->capacity) return true;
+  if (!vec->size)
+  {
+    MEM_Deallocate(mem, vec->data);
+    vec->data = nullptr;
+    vec->capacity = 0;
+    return true;
+  }
+  PTR data = DS_VectorReallocate(mem, vec->data, element_size, vec->size);
+  if (!data) return false;
+  vec->data = data;
+  vec->capacity = vec->size;
+  return true;
+}
+
+bool __DS_Vector32AppendArray(MEM *mem, PTR _vec, UZ element_size, ConstPtr items, UZ count)
+{
+  __DS_Vector32 *vec = _vec;
+  PTR old_data = vec->data;
+  if (count > MAX_U32 - vec->size || !__DS_Vector32Grow(mem, vec, element_size, vec->size + count)) return false;
+  items = DS_VectorItems(items, old_data, vec->data, vec->size * element_size);
+  MemoryCopy((U8*)vec->data + vec->size * element_size, items, count * element_size);
+  vec->size += (U32)count;
+  return true;
+}
+
+typedef struct __DS_SmallVector
+{
+  PTR heap;
+  UZ size;
+  UZ capacity;
+} __DS_SmallVector;
+
+bool __DS_SmallVectorReserve(MEM *mem, PTR _vec, UZ element_size, ConstPtr items, UZ capacity)
+{
+  __DS_SmallVector *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  PTR heap = DS_VectorReallocate(mem, vec->heap, element_size, capacity);
+  if (!heap) return false;
+  if (!vec->heap) MemoryCopy(heap, items, vec->size * element_size);
+  vec->heap = heap;
+  vec->capacity = capacity;
+  return true;
+}
+
+bool __DS_SmallVectorGrow(MEM *mem, PTR _vec, UZ element_size, ConstPtr items, UZ capacity)
+{
+  __DS_SmallVector *vec = _vec;
+  if (capacity <= vec->capacity) return true;
+  return __DS_SmallVectorReserve(mem, vec, element_size, items, DS_VectorGrowth(vec->capacity, capacity, MAX_UZ / element_size));
+}
+
+bool __DS_SmallVectorShrinkToFit(MEM *mem, PTR _vec, UZ element_size, PTR items, UZ inline_capacity)
+{
+  __DS_SmallVector *vec = _vec;
+  if (!vec->heap || vec->size == vec->capacity) return true;
+  if (vec->size <= inline_capacity)
+  {
+    MemoryCopy(items, vec->heap, vec->size * element_size);
+    MEM_Deallocate(mem, vec->heap);
+    vec->heap = nullptr;
+    vec->capacity = inline_capacity;
+    return true;
+  }
+  PTR heap = DS_VectorReallocate(mem, vec->heap, element_size, vec->size);
+  if (!heap) return false;
+  vec->heap = heap;
+  vec->capacity = vec->size;
+  return true;
+}
+
+bool __DS_SmallVectorAppendArray(MEM *mem, PTR _vec, UZ element_size, PTR items, ConstPtr values, UZ count)
+{
+  __DS_SmallVector *vec = _vec;
+  PTR old_heap = vec->heap;
+  if (count > MAX_UZ - vec->size || !__DS_SmallVectorGrow(mem, vec, element_size, items, vec->size + count)) return false;
+  values = DS_VectorItems(values, old_heap, vec->heap, vec->size * element_size);
+  U8 *data = vec->heap ? vec->heap : items;
+  MemoryCopy(data + vec->size * element_size, values, count * element_size);
+  vec->size += count;
+  return true;
+}
+
+typedef struct __DS_Ring
+{
+  U8 *data;
+  UZ head;
+  UZ size;
+  UZ capacity;
+} __DS_Ring;
+
+bool __DS_RingReserve(MEM *mem, PTR _ring, UZ element_size, UZ capacity)
+{
+  __DS_Ring *ring = _ring;
+  if (capacity <= ring->capacity) return true;
+  UZ grown = Max(ring->capacity, (UZ)DS_VECTOR_MIN_CAPACITY);
+  while (grown < capacity)
+  {
+    if (grown > MAX_UZ / 2) return false;
+    grown *= 2;
+  }
+  U8 *data = DS_VectorReallocate(mem, ring->data, element_size, grown);
+  if (!data) return false;
+  /* At least doubling the capacity leaves room to move either the values
+     that wrapped around behind the old end, or the ones before it to the new
+     end, whichever are fewer. */
+  UZ end = ring->capacity - ring->head;
+  if (ring->size > end)
+  {
+    UZ wrapped = ring->size - end;
+    if (wrapped <= end)
+    {
+      MemoryCopy(data + ring->capacity * element_size, data, wrapped * element_size);
+    }
+    else
+    {
+      MemoryCopy(data + (grown - end) * element_size, data + ring->head * element_size, end * element_size);
+      ring->head = grown - end;
+    }
+  }
+  ring->data = data;
+  ring->capacity = grown;
+  return true;
+}
+
+/* Copies between items and the ring starting at a position, in up to two spans. */
+static void DS_RingCopy(__DS_Ring *ring, UZ element_size, UZ position, PTR items, UZ count, bool into)
+{
+  if (!count) return;
+  UZ first = Min(count, ring->capacity - position);
+  U8 *data = ring->data + position * element_size;
+  U8 *other = items;
+  if (into)
+  {
+    MemoryCopy(data, other, first * element_size);
+    MemoryCopy(ring->data, other + first * element_size, (count - first) * element_size);
+  }
+  else
+  {
+    MemoryCopy(other, data, first * element_size);
+    MemoryCopy(other + first * element_size, ring->data, (count - first) * element_size);
+  }
+}
+
+bool __DS_RingPushBackArray(MEM *mem, PTR _ring, UZ element_size, ConstPtr items, UZ count)
+{
+  __DS_Ring *ring = _ring;
+  if (count > MAX_UZ - ring->size || !__DS_RingReserve(mem, ring, element_size, ring->size + count)) return false;
+  DS_RingCopy(ring, element_size, (ring->head + ring->size) & (ring->capacity - 1), (PTR)items, count, true);
+  ring->size += count;
+  return true;
+}
+
+bool __DS_RingPushFrontArray(MEM *mem, PTR _ring, UZ element_size, ConstPtr items, UZ count)
+{
+  __DS_Ring *ring = _ring;
+  if (count > MAX_UZ - ring->size || !__DS_RingReserve(mem, ring, element_size, ring->size + count)) return false;
+  ring->head = (ring->head - count) & (ring->capacity - 1);
+  DS_RingCopy(ring, element_size, ring->head, (PTR)items, count, true);
+  ring->size += count;
+  return true;
+}
+
+UZ __DS_RingPopFrontArray(PTR _ring, UZ element_size, PTR items, UZ count)
+{
+  __DS_Ring *ring = _ring;
+  count = Min(count, ring->size);
+  if (items) DS_RingCopy(ring, element_size, ring->head, items, count, false);
+  ring->head = (ring->head + count) & (ring->capacity - 1);
+  ring->size -= count;
+  return count;
+}
+
+UZ __DS_RingPopBackArray(PTR _ring, UZ element_size, PTR items, UZ count)
+{
+  __DS_Ring *ring = _ring;
+  count = Min(count, ring->size);
+  ring->size -= count;
+  if (items) DS_RingCopy(ring, element_size, (ring->head + ring->size) & (ring->capacity - 1), items, count, false);
+  return count;
+}
 
 typedef struct __DS_ListNode
 {
@@ -6,14 +299,29 @@ typedef struct __DS_ListNode
   struct __DS_ListNode *prev;
 } __DS_ListNode;
 
+#define DS_Distance(a, b) ((a) < (b) ? (b) - (a) : (a) - (b))
+
 PTR DS_ListGetNode(DS_List *list, UZ index)
 {
   if (!list || index >= list->size) return nullptr;
-  for (__DS_ListNode *node = list->first; node; node = node->next)
+  /* walks from the nearest of the first node, the last node and the cursor */
+  __DS_ListNode *node = list->first;
+  UZ position = 0;
+  if (list->size - 1 - index < index)
   {
-    if (!index--) return node;
+    node = list->last;
+    position = list->size - 1;
   }
-  return nullptr;
+  if (list->cursor && DS_Distance(list->cursor_index, index) < DS_Distance(position, index))
+  {
+    node = list->cursor;
+    position = list->cursor_index;
+  }
+  for (; position < index; ++position) node = node->next;
+  for (; position > index; --position) node = node->prev;
+  list->cursor = node;
+  list->cursor_index = index;
+  return node;
 }
 
 PTR DS_ListRemoveNode(DS_List *list, UZ index)
@@ -27,6 +335,8 @@ PTR DS_ListRemoveNode(DS_List *list, UZ index)
     if (node->prev) node->prev->next = node->next;
     else list->first = node->next;
 
+    /* the following node takes the index of the removed one */
+    list->cursor = node->next;
     node->next = nullptr;
     node->prev = nullptr;
     list->size--;
@@ -52,6 +362,7 @@ void DS_ListInsertNode(DS_List *list, UZ index, PTR _node)
     node->next = next;
     next->prev = node;
     list->size++;
+    list->cursor = node;
   }
 }
 
@@ -65,9 +376,163 @@ void DS_ListPrependNode(DS_List *list, PTR node)
   DS_ListInsertNode(list, 0, node);
 }
 
+typedef struct __DS_UnrolledNode
+{
+  struct __DS_UnrolledNode *next;
+  struct __DS_UnrolledNode *prev;
+  UZ count;
+} __DS_UnrolledNode;
+
+#define DS_UnrolledValue(node, offset, size, i) ((U8*)(node) + (offset) + (i) * (size))
+
+/* Returns the node holding the index and the index of its first value, walking from the nearest known node. */
+static __DS_UnrolledNode *DS_UnrolledListFind(DS_UnrolledList *list, UZ index, UZ *base)
+{
+  __DS_UnrolledNode *node = list->first, *last = list->last;
+  UZ position = 0;
+  if (DS_Distance(list->size - last->count, index) < index)
+  {
+    node = last;
+    position = list->size - last->count;
+  }
+  if (list->cursor && DS_Distance(list->cursor_index, index) < DS_Distance(position, index))
+  {
+    node = list->cursor;
+    position = list->cursor_index;
+  }
+  while (index < position)
+  {
+    node = node->prev;
+    position -= node->count;
+  }
+  while (index >= position + node->count)
+  {
+    position += node->count;
+    node = node->next;
+  }
+  list->cursor = node;
+  list->cursor_index = *base = position;
+  return node;
+}
+
+static void DS_UnrolledListLink(DS_UnrolledList *list, __DS_UnrolledNode *node, __DS_UnrolledNode *prev)
+{
+  node->prev = prev;
+  node->next = prev ? prev->next : list->first;
+  if (node->next) node->next->prev = node;
+  else list->last = node;
+  if (prev) prev->next = node;
+  else list->first = node;
+}
+
+static void DS_UnrolledListUnlink(MEM *mem, DS_UnrolledList *list, __DS_UnrolledNode *node)
+{
+  if (node->next) node->next->prev = node->prev;
+  else list->last = node->prev;
+  if (node->prev) node->prev->next = node->next;
+  else list->first = node->next;
+  MEM_Deallocate(mem, node);
+}
+
+PTR __DS_UnrolledListAt(DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index)
+{
+  (void)capacity;
+  if (!list || index >= list->size) return nullptr;
+  UZ base;
+  __DS_UnrolledNode *node = DS_UnrolledListFind(list, index, &base);
+  return DS_UnrolledValue(node, offset, size, index - base);
+}
+
+PTR __DS_UnrolledListInsert(MEM *mem, DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index, ConstPtr value)
+{
+  if (!list || index > list->size) return nullptr;
+  UZ base = list->size;
+  __DS_UnrolledNode *node = list->last;
+  if (index < list->size) node = DS_UnrolledListFind(list, index, &base);
+  else if (node) base -= node->count;
+  if (!node || node->count == capacity)
+  {
+    __DS_UnrolledNode *split = MEM_Allocate(mem, offset + capacity * size);
+    if (!split) return nullptr;
+    split->count = 0;
+    DS_UnrolledListLink(list, split, node);
+    if (!node) node = split;
+    else if (index - base == node->count)
+    {
+      /* appending to a full node starts the next one instead of splitting it */
+      base += node->count;
+      node = split;
+    }
+    else
+    {
+      UZ half = capacity / 2;
+      split->count = node->count - half;
+      MemoryCopy(DS_UnrolledValue(split, offset, size, 0), DS_UnrolledValue(node, offset, size, half), split->count * size);
+      node->count = half;
+      if (index - base > half)
+      {
+        base += half;
+        node = split;
+      }
+    }
+  }
+  UZ i = index - base;
+  U8 *slot = DS_UnrolledValue(node, offset, size, i);
+  MemoryCopy(slot + size, slot, (node->count - i) * size);
+  MemoryCopy(slot, value, size);
+  node->count++;
+  list->size++;
+  list->cursor = node;
+  list->cursor_index = base;
+  return slot;
+}
+
+bool __DS_UnrolledListRemove(MEM *mem, DS_UnrolledList *list, UZ size, UZ capacity, UZ offset, UZ index)
+{
+  if (!list || index >= list->size) return false;
+  UZ base;
+  __DS_UnrolledNode *node = DS_UnrolledListFind(list, index, &base);
+  U8 *slot = DS_UnrolledValue(node, offset, size, index - base);
+  MemoryCopy(slot, slot + size, (node->count - (index - base) - 1) * size);
+  node->count--;
+  list->size--;
+  /* nodes below half capacity are merged with a neighbour when they fit in one */
+  __DS_UnrolledNode *next = node->next;
+  if (node->count < capacity / 2 && node->prev && node->prev->count + node->count <= capacity)
+  {
+    next = node;
+    node = node->prev;
+    base -= node->count;
+  }
+  if (next && node->count + next->count <= capacity && (node->count < capacity / 2 || next->count < capacity / 2))
+  {
+    MemoryCopy(DS_UnrolledValue(node, offset, size, node->count), DS_UnrolledValue(next, offset, size, 0), next->count * size);
+    node->count += next->count;
+    DS_UnrolledListUnlink(mem, list, next);
+  }
+  if (!node->count)
+  {
+    DS_UnrolledListUnlink(mem, list, node);
+    node = nullptr;
+  }
+  list->cursor = node;
+  list->cursor_index = base;
+  return true;
+}
+
+void DS_UnrolledListClear(MEM *mem, DS_UnrolledList *list)
+{
+  for (__DS_UnrolledNode *node = list->first, *next; node; node = next)
+  {
+    next = node->next;
+    MEM_Deallocate(mem, node);
+  }
+  MemoryZeroStruct(list);
+}
+
 DS_BitField DS_BitFieldAllocate(MEM *mem, UZ width)
 {
-  DS_BitField field = { MEM_AllocateZero(mem, (width + 7) >> 3) };
+  DS_BitField field = { .data = MEM_AllocateZero(mem, DS_BitFieldWords(width) * sizeof(U64)) };
   if (field.data) field.width = width;
   return field;
 }
@@ -75,31 +540,1614 @@ DS_BitField DS_BitFieldAllocate(MEM *mem, UZ width)
 bool DS_BitFieldGet(DS_BitField bits, UZ index)
 {
   if (index >= bits.width) return 0;
-  UZ offset = index >> 3;
-  UZ shift = index & 7;
-  return ((bits.data[offset] >> shift) & 1);
+  return (bits.data[index >> 6] >> (index & 63)) & 1;
 }
 
 bool DS_BitFieldFlip(DS_BitField bits, UZ index)
 {
   if (index >= bits.width) return 0;
-  UZ offset = index >> 3;
-  UZ shift = index & 7;
-  return (((bits.data[offset] ^= (U8)(1 << shift)) >> shift) & 1);
+  return ((bits.data[index >> 6] ^= 1ULL << (index & 63)) >> (index & 63)) & 1;
 }
 
 void DS_BitFieldSet(DS_BitField bits, UZ index)
 {
   if (index >= bits.width) return;
-  UZ offset = index >> 3;
-  UZ shift = index & 7;
-  bits.data[offset] |= (U8)(1 << shift);
+  bits.data[index >> 6] |= 1ULL << (index & 63);
 }
 
 void DS_BitFieldClear(DS_BitField bits, UZ index)
 {
   if (index >= bits.width) return;
-  UZ offset = index >> 3;
-  UZ shift = index & 7;
-  bits.data[offset] &= ~(U8)(1 << shift);
+  bits.data[index >> 6] &= ~(1ULL << (index & 63));
+}
+
+void DS_BitFieldSetRange(DS_BitField bits, UZ begin, UZ end)
+{
+  end = Min(end, bits.width);
+  if (begin >= end) return;
+  UZ first = begin >> 6, last = (end - 1) >> 6;
+  U64 head = MAX_U64 << (begin & 63), tail = MAX_U64 >> (63 - ((end - 1) & 63));
+  if (first == last)
+  {
+    bits.data[first] |= head & tail;
+    return;
+  }
+  bits.data[first] |= head;
+  memset(bits.data + first + 1, 0xFF, (last - first - 1) * sizeof(U64));
+  bits.data[last] |= tail;
+}
+
+void DS_BitFieldClearRange(DS_BitField bits, UZ begin, UZ end)
+{
+  end = Min(end, bits.width);
+  if (begin >= end) return;
+  UZ first = begin >> 6, last = (end - 1) >> 6;
+  U64 head = MAX_U64 << (begin & 63), tail = MAX_U64 >> (63 - ((end - 1) & 63));
+  if (first == last)
+  {
+    bits.data[first] &= ~(head & tail);
+    return;
+  }
+  bits.data[first] &= ~head;
+  memset(bits.data + first + 1, 0, (last - first - 1) * sizeof(U64));
+  bits.data[last] &= ~tail;
+}
+
+UZ DS_BitFieldCount(DS_BitField bits)
+{
+  UZ words = DS_BitFieldWords(bits.width), count = 0, i = 0;
+  /* counts the bits of each nibble with a shuffle, summing the bytes with SAD */
+#if defined(SIMD_AVX2)
+  __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  __m256i nibble = _mm256_set1_epi8(0x0F), sums = _mm256_setzero_si256();
+  for (UZ end = words & ~(UZ)3; i < end; i += 4)
+  {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(bits.data + i));
+    __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble)),
+                                     _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+  U64 lanes[4];
+  _mm256_storeu_si256((__m256i*)lanes, sums);
+  count = (UZ)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#elif defined(SIMD_SSSE3)
+  __m128i table = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  __m128i nibble = _mm_set1_epi8(0x0F), sums = _mm_setzero_si128();
+  for (UZ end = words & ~(UZ)1; i < end; i += 2)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*)(bits.data + i));
+    __m128i counts = _mm_add_epi8(_mm_shuffle_epi8(table, _mm_and_si128(v, nibble)),
+                                  _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), nibble)));
+    sums = _mm_add_epi64(sums, _mm_sad_epu8(counts, _mm_setzero_si128()));
+  }
+  U64 lanes[2];
+  _mm_storeu_si128((__m128i*)lanes, sums);
+  count = (UZ)(lanes[0] + lanes[1]);
+#elif defined(SIMD_NEON)
+  for (UZ end = words & ~(UZ)1; i < end; i += 2)
+  {
+    count += vaddlvq_u8(vcntq_u8(vld1q_u8((const U8*)(bits.data + i))));
+  }
+#endif
+  for (; i < words; ++i)
+  {
+    count += PopCount64(bits.data[i]);
+  }
+  return count;
+}
+
+UZ DS_BitFieldFindSet(DS_BitField bits, UZ offset)
+{
+  if (offset >= bits.width) return bits.width;
+  UZ i = offset >> 6, words = DS_BitFieldWords(bits.width);
+  for (U64 word = bits.data[i] & (MAX_U64 << (offset & 63));; word = bits.data[i])
+  {
+    if (word) return (i << 6) + CountTrailingZeros64(word);
+    if (++i == words) return bits.width;
+  }
+}
+
+UZ DS_BitFieldFindClear(DS_BitField bits, UZ offset)
+{
+  if (offset >= bits.width) return bits.width;
+  UZ i = offset >> 6, words = DS_BitFieldWords(bits.width);
+  for (U64 word = ~bits.data[i] & (MAX_U64 << (offset & 63));; word = ~bits.data[i])
+  {
+    if (word) return Min((i << 6) + CountTrailingZeros64(word), bits.width);
+    if (++i == words) return bits.width;
+  }
+}
+
+/* Defines a function combining whole fields with the given vector and scalar operations. */
+#define DS_BitFieldCombineDefine(name, avx2, sse2, neon, scalar, clear_rest)  \
+void name(DS_BitField bits, DS_BitField other)                               \
+{                                                                            \
+  UZ words = DS_BitFieldWords(Min(bits.width, other.width)), i = 0;          \
+  U64 *a = bits.data;                                                        \
+  const U64 *b = other.data;                                                 \
+  DS_BitFieldCombineLoop(avx2, sse2, neon)                                   \
+  for (; i < words; ++i) a[i] = scalar;                                      \
+  if (clear_rest)                                                            \
+  {                                                                          \
+    memset(a + words, 0, (DS_BitFieldWords(bits.width) - words) * sizeof(U64)); \
+  }                                                                          \
+  if (bits.width < other.width && (bits.width & 63))                         \
+  {                                                                          \
+    a[words - 1] &= MAX_U64 >> (64 - (bits.width & 63));                     \
+  }                                                                          \
+}
+
+#if defined(SIMD_AVX2)
+#define DS_BitFieldCombineLoop(avx2, sse2, neon)                              \
+  for (UZ end = words & ~(UZ)3; i < end; i += 4)                             \
+  {                                                                          \
+    __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));                 \
+    __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));                 \
+    _mm256_storeu_si256((__m256i*)(a + i), avx2);                            \
+  }
+#elif defined(SIMD_SSE2)
+#define DS_BitFieldCombineLoop(avx2, sse2, neon)                              \
+  for (UZ end = words & ~(UZ)1; i < end; i += 2)                             \
+  {                                                                          \
+    __m128i x = _mm_loadu_si128((const __m128i*)(a + i));                    \
+    __m128i y = _mm_loadu_si128((const __m128i*)(b + i));                    \
+    _mm_storeu_si128((__m128i*)(a + i), sse2);                               \
+  }
+#elif defined(SIMD_NEON)
+#define DS_BitFieldCombineLoop(avx2, sse2, neon)                              \
+  for (UZ end = words & ~(UZ)1; i < end; i += 2)                             \
+  {                                                                          \
+    uint64x2_t x = vld1q_u64(a + i);                                         \
+    uint64x2_t y = vld1q_u64(b + i);                                         \
+    vst1q_u64(a + i, neon);                                                  \
+  }
+#else
+#define DS_BitFieldCombineLoop(avx2, sse2, neon)
+#endif
+
+DS_BitFieldCombineDefine(DS_BitFieldAnd, _mm256_and_si256(x, y), _mm_and_si128(x, y), vandq_u64(x, y), a[i] & b[i], true)
+DS_BitFieldCombineDefine(DS_BitFieldOr, _mm256_or_si256(x, y), _mm_or_si128(x, y), vorrq_u64(x, y), a[i] | b[i], false)
+DS_BitFieldCombineDefine(DS_BitFieldXor, _mm256_xor_si256(x, y), _mm_xor_si128(x, y), veorq_u64(x, y), a[i] ^ b[i], false)
+DS_BitFieldCombineDefine(DS_BitFieldAndNot, _mm256_andnot_si256(y, x), _mm_andnot_si128(y, x), vbicq_u64(x, y), a[i] & ~b[i], false)
+
+#define X(T)                                                            \
+static U64 Glue(DS_HashKeyHash_, T)(ConstPtr key)                       \
+{                                                                       \
+  U64 bits = 0;                                                         \
+  MemoryCopy(&bits, key, sizeof(T));                                    \
+  return bits;                                                          \
+}                                                                       \
+static bool Glue(DS_HashKeyEquals_, T)(ConstPtr left, ConstPtr right)   \
+{                                                                       \
+  return !memcmp(left, right, sizeof(T));                               \
+}                                                                       \
+const DS_HashKey DS_HashKeyOf(T) = { sizeof(T), Glue(DS_HashKeyHash_, T), Glue(DS_HashKeyEquals_, T) }
+X(S8); X(S16); X(S32); X(S64); X(SZ); X(SP);
+X(U8); X(U16); X(U32); X(U64); X(UZ); X(UP);
+X(B8); X(B16); X(B32); X(B64);
+X(F32); X(F64); X(PTR);
+#undef X
+
+static U64 DS_HashKeyHash_STR(ConstPtr key)
+{
+  return STR_Hash64(*(const STR*)key);
+}
+
+static bool DS_HashKeyEquals_STR(ConstPtr left, ConstPtr right)
+{
+  return STR_Equals(*(const STR*)left, *(const STR*)right);
+}
+
+static U64 DS_HashKeyHash_STR16(ConstPtr key)
+{
+  const STR16 *string = key;
+  return STR_Hash64((STR) { (U8*)string->str, string->size * sizeof(U16) });
+}
+
+static bool DS_HashKeyEquals_STR16(ConstPtr left, ConstPtr right)
+{
+  const STR16 *l = left, *r = right;
+  return l->size == r->size && (l->str == r->str || !memcmp(l->str, r->str, l->size * sizeof(U16)));
+}
+
+static U64 DS_HashKeyHash_USTR(ConstPtr key)
+{
+  return USTR_Hash64(*(const USTR*)key);
+}
+
+static bool DS_HashKeyEquals_USTR(ConstPtr left, ConstPtr right)
+{
+  return USTR_Equals(*(const USTR*)left, *(const USTR*)right);
+}
+
+const DS_HashKey DS_HASH_KEY_STR = { sizeof(STR), DS_HashKeyHash_STR, DS_HashKeyEquals_STR };
+const DS_HashKey DS_HASH_KEY_STR16 = { sizeof(STR16), DS_HashKeyHash_STR16, DS_HashKeyEquals_STR16 };
+const DS_HashKey DS_HASH_KEY_USTR = { sizeof(USTR), DS_HashKeyHash_USTR, DS_HashKeyEquals_USTR };
+
+typedef struct __DS_HashMap
+{
+  MEM *mem;
+  U8 *controls;
+  U8 *entries;
+  UZ size;
+  UZ capacity;
+  UZ growth;
+} __DS_HashMap;
+
+#define DS_HASH_EMPTY 0x80
+#define DS_HASH_DELETED 0xFE
+#define DS_HASH_MIN_CAPACITY 16
+#define DS_HashMaxLoad(capacity) ((capacity) - (capacity) / 8)
+
+/* Group masks have one bit for each matching control byte, lane i at bit (i << DS_HASH_LANE_SHIFT). */
+#if defined(SIMD_SSE2)
+#define DS_HASH_GROUP 16
+#define DS_HASH_LANE_SHIFT 0
+#define DS_HASH_LANES 0xFFFFULL
+
+static U64 DS_HashGroupMatch(const U8 *controls, U8 control)
+{
+  return (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)controls), _mm_set1_epi8((char)control)));
+}
+
+static U64 DS_HashGroupFree(const U8 *controls)
+{
+  return (U32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)controls));
+}
+#elif defined(SIMD_NEON)
+#define DS_HASH_GROUP 16
+#define DS_HASH_LANE_SHIFT 2
+#define DS_HASH_LANES 0x8888888888888888ULL
+
+/* narrows the 0x00/0xFF lanes to nibbles */
+static U64 DS_HashGroupMask(uint8x16_t lanes)
+{
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4)), 0) & DS_HASH_LANES;
+}
+
+static U64 DS_HashGroupMatch(const U8 *controls, U8 control)
+{
+  return DS_HashGroupMask(vceqq_u8(vld1q_u8(controls), vdupq_n_u8(control)));
+}
+
+static U64 DS_HashGroupFree(const U8 *controls)
+{
+  return DS_HashGroupMask(vtstq_u8(vld1q_u8(controls), vdupq_n_u8(0x80)));
+}
+#else
+#define DS_HASH_GROUP 8
+#define DS_HASH_LANE_SHIFT 3
+#define DS_HASH_LANES 0x8080808080808080ULL
+
+static U64 DS_HashGroupMatch(const U8 *controls, U8 control)
+{
+  U64 word, ones = 0x0101010101010101ULL;
+  MemoryCopy(&word, controls, sizeof(word));
+  word ^= control * ones;
+  /* sets the high bit of every zero byte, without borrows between bytes */
+  return ~(((word & (0x7F * ones)) + 0x7F * ones) | word | (0x7F * ones));
+}
+
+static U64 DS_HashGroupFree(const U8 *controls)
+{
+  U64 word;
+  MemoryCopy(&word, controls, sizeof(word));
+  return word & DS_HASH_LANES;
+}
+#endif
+
+#define DS_HashGroupFirst(mask) (CountTrailingZeros64(mask) >> DS_HASH_LANE_SHIFT)
+#define DS_HashGroupLast(mask) (CountLeadingZeros64((mask) << (64 - (DS_HASH_GROUP << DS_HASH_LANE_SHIFT))) >> DS_HASH_LANE_SHIFT)
+
+static U64 DS_HashMix(U64 hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/* The control bytes are followed by a copy of the first group, so any position starts a whole group. */
+static void DS_HashMapSetControl(__DS_HashMap *map, UZ index, U8 control)
+{
+  map->controls[index] = control;
+  if (index < DS_HASH_GROUP) map->controls[map->capacity + index] = control;
+}
+
+/* Returns the entry with the key or null, probing groups in triangular steps from the hash. */
+static U8 *DS_HashMapProbe(__DS_HashMap *map, const DS_HashKey *type, UZ entry_size, ConstPtr key, U64 hash)
+{
+  UZ mask = map->capacity - 1;
+  for (UZ position = (UZ)(hash >> 7) & mask, step = DS_HASH_GROUP;; position = (position + step) & mask, step += DS_HASH_GROUP)
+  {
+    const U8 *group = map->controls + position;
+    for (U64 match = DS_HashGroupMatch(group, hash & 0x7F); match; match &= match - 1)
+    {
+      U8 *entry = map->entries + ((position + DS_HashGroupFirst(match)) & mask) * entry_size;
+      if (type->equals(entry, key)) return entry;
+    }
+    if (DS_HashGroupMatch(group, DS_HASH_EMPTY)) return nullptr;
+  }
+}
+
+/* Returns the first empty or deleted slot on the probe sequence of the hash. */
+static UZ DS_HashMapFindFree(__DS_HashMap *map, U64 hash)
+{
+  UZ mask = map->capacity - 1;
+  for (UZ position = (UZ)(hash >> 7) & mask, step = DS_HASH_GROUP;; position = (position + step) & mask, step += DS_HASH_GROUP)
+  {
+    U64 free = DS_HashGroupFree(map->controls + position);
+    if (free) return (position + DS_HashGroupFirst(free)) & mask;
+  }
+}
+
+/* The entries and the control bytes after them share one block, which grows
+   with MEM_Reallocate so arenas extend it in place; the entries are then
+   rehashed in place, so an entry that is not in its first probe group swaps
+   with the one in its way until every entry is settled. */
+static bool DS_HashMapResize(__DS_HashMap *map, const DS_HashKey *type, UZ entry_size, UZ capacity)
+{
+  U8 *entries = MEM_Reallocate(map->mem, map->entries, capacity * entry_size + capacity + DS_HASH_GROUP);
+  if (!entries) return false;
+  UZ previous = map->capacity;
+  map->entries = entries;
+  map->controls = entries + capacity * entry_size;
+  map->capacity = capacity;
+  map->growth = DS_HashMaxLoad(capacity) - map->size;
+  MemoryCopy(map->controls, entries + previous * entry_size, previous);
+  /* full slots become deleted to mark them as pending, deleted ones become empty */
+  for (UZ i = 0; i < previous; ++i)
+  {
+    map->controls[i] = map->controls[i] & 0x80 ? DS_HASH_EMPTY : DS_HASH_DELETED;
+  }
+  memset(map->controls + previous, DS_HASH_EMPTY, capacity - previous);
+  MemoryCopy(map->controls + capacity, map->controls, DS_HASH_GROUP);
+  UZ mask = capacity - 1;
+  for (UZ i = 0; i < previous; ++i)
+  {
+    if (map->controls[i] != DS_HASH_DELETED) continue;
+    U8 *entry = entries + i * entry_size;
+    U64 hash = DS_HashMix(type->hash(entry));
+    UZ start = (UZ)(hash >> 7) & mask;
+    UZ index = DS_HashMapFindFree(map, hash);
+    if (((index - start) & mask) / DS_HASH_GROUP == ((i - start) & mask) / DS_HASH_GROUP)
+    {
+      DS_HashMapSetControl(map, i, hash & 0x7F);
+      continue;
+    }
+    U8 *target = entries + index * entry_size;
+    if (map->controls[index] == DS_HASH_EMPTY)
+    {
+      MemoryCopy(target, entry, entry_size);
+      DS_HashMapSetControl(map, i, DS_HASH_EMPTY);
+    }
+    else
+    {
+      /* the slot holds a pending entry, which is placed next from this slot */
+      for (UZ j = 0; j < entry_size; ++j)
+      {
+        U8 byte = entry[j];
+        entry[j] = target[j];
+        target[j] = byte;
+      }
+      --i;
+    }
+    DS_HashMapSetControl(map, index, hash & 0x7F);
+  }
+  return true;
+}
+
+PTR __DS_HashMapFind(PTR _map, const DS_HashKey *type, UZ entry_size, ConstPtr key)
+{
+  __DS_HashMap *map = _map;
+  if (!map->size) return nullptr;
+  return DS_HashMapProbe(map, type, entry_size, key, DS_HashMix(type->hash(key)));
+}
+
+PTR __DS_HashMapInsert(PTR _map, const DS_HashKey *type, UZ entry_size, ConstPtr key)
+{
+  __DS_HashMap *map = _map;
+  U64 hash = DS_HashMix(type->hash(key));
+  U8 *entry = map->size ? DS_HashMapProbe(map, type, entry_size, key, hash) : nullptr;
+  if (entry) return entry;
+  UZ index = map->capacity ? DS_HashMapFindFree(map, hash) : 0;
+  if (!map->capacity || (!map->growth && map->controls[index] == DS_HASH_EMPTY))
+  {
+    /* tables filled up by deleted entries are rebuilt at the same capacity */
+    UZ capacity = DS_HASH_MIN_CAPACITY;
+    if (map->capacity) capacity = map->size < DS_HashMaxLoad(map->capacity) / 2 ? map->capacity : map->capacity << 1;
+    if (capacity > MAX_UZ / 2 / entry_size || !DS_HashMapResize(map, type, entry_size, capacity)) return nullptr;
+    index = DS_HashMapFindFree(map, hash);
+  }
+  map->growth -= map->controls[index] == DS_HASH_EMPTY;
+  map->size++;
+  DS_HashMapSetControl(map, index, hash & 0x7F);
+  entry = map->entries + index * entry_size;
+  memset(entry, 0, entry_size);
+  MemoryCopy(entry, key, type->size);
+  return entry;
+}
+
+bool __DS_HashMapRemove(PTR _map, const DS_HashKey *type, UZ entry_size, ConstPtr key)
+{
+  __DS_HashMap *map = _map;
+  U8 *entry = map->size ? DS_HashMapProbe(map, type, entry_size, key, DS_HashMix(type->hash(key))) : nullptr;
+  if (!entry) return false;
+  UZ index = (UZ)(entry - map->entries) / entry_size;
+  U64 before = DS_HashGroupMatch(map->controls + ((index - DS_HASH_GROUP) & (map->capacity - 1)), DS_HASH_EMPTY);
+  U64 after = DS_HashGroupMatch(map->controls + index, DS_HASH_EMPTY);
+  /* without a full group around the entry no probe sequence went past it, so it can become empty again */
+  bool empty = before && after && DS_HashGroupLast(before) + DS_HashGroupFirst(after) < DS_HASH_GROUP;
+  DS_HashMapSetControl(map, index, empty ? DS_HASH_EMPTY : DS_HASH_DELETED);
+  map->growth += empty;
+  map->size--;
+  return true;
+}
+
+bool __DS_HashMapReserve(PTR _map, const DS_HashKey *type, UZ entry_size, UZ count)
+{
+  __DS_HashMap *map = _map;
+  UZ capacity = DS_HASH_MIN_CAPACITY;
+  while (DS_HashMaxLoad(capacity) < count)
+  {
+    if (capacity > MAX_UZ / 4 / entry_size) return false;
+    capacity <<= 1;
+  }
+  return capacity <= map->capacity || DS_HashMapResize(map, type, entry_size, capacity);
+}
+
+PTR __DS_HashMapNext(PTR _map, UZ entry_size, PTR entry)
+{
+  __DS_HashMap *map = _map;
+  UZ start = entry ? (UZ)((U8*)entry - map->entries) / entry_size + 1 : 0;
+  for (UZ i = start; i < map->capacity; i += DS_HASH_GROUP)
+  {
+    U64 full = ~DS_HashGroupFree(map->controls + i) & DS_HASH_LANES;
+    if (!full) continue;
+    UZ index = i + DS_HashGroupFirst(full);
+    return index < map->capacity ? map->entries + index * entry_size : nullptr;
+  }
+  return nullptr;
+}
+
+void DS_HashMapClear(PTR _map)
+{
+  __DS_HashMap *map = _map;
+  if (map->controls) memset(map->controls, DS_HASH_EMPTY, map->capacity + DS_HASH_GROUP);
+  map->size = 0;
+  map->growth = DS_HashMaxLoad(map->capacity);
+}
+
+void DS_HashMapFree(PTR _map)
+{
+  __DS_HashMap *map = _map;
+  if (map->entries) MEM_Deallocate(map->mem, map->entries);
+  MemoryZeroStruct(map);
+}
+
+#define DS_BTREE_64_SIGN 0x8000000000000000ULL
+
+/* Counts the keys less than the given one, comparing them as signed after
+   flipping the sign bit, which orders unsigned keys too. */
+static UZ DS_BTreeSearch32(const U32 *keys, UZ count, U32 key, U32 flip)
+{
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  __m256i flips = _mm256_set1_epi32((int)flip);
+  __m256i value = _mm256_set1_epi32((int)(key ^ flip));
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(keys + i)), flips);
+    U32 less = (U32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(value, lanes)));
+    if (less != 0xFF) return i + CountTrailingZeros32(~less);
+  }
+#elif defined(SIMD_SSE2)
+  __m128i flips = _mm_set1_epi32((int)flip);
+  __m128i value = _mm_set1_epi32((int)(key ^ flip));
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(keys + i)), flips);
+    U32 less = (U32)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(value, lanes)));
+    if (less != 0xF) return i + CountTrailingZeros32(~less);
+  }
+#elif defined(SIMD_NEON)
+  uint32x4_t flips = vdupq_n_u32(flip);
+  int32x4_t value = vdupq_n_s32((S32)(key ^ flip));
+  for (; i + 4 <= count; i += 4)
+  {
+    int32x4_t lanes = vreinterpretq_s32_u32(veorq_u32(vld1q_u32(keys + i), flips));
+    U32 less = vaddvq_u32(vshrq_n_u32(vcltq_s32(lanes, value), 31));
+    if (less != 4) return i + less;
+  }
+#endif
+  while (i < count && (S32)(keys[i] ^ flip) < (S32)(key ^ flip)) ++i;
+  return i;
+}
+
+static UZ DS_BTreeSearch64(const U64 *keys, UZ count, U64 key, U64 flip)
+{
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  __m256i flips = _mm256_set1_epi64x((S64)flip);
+  __m256i value = _mm256_set1_epi64x((S64)(key ^ flip));
+  for (; i + 4 <= count; i += 4)
+  {
+    __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(keys + i)), flips);
+    U32 less = (U32)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(value, lanes)));
+    if (less != 0xF) return i + CountTrailingZeros32(~less);
+  }
+#elif defined(SIMD_SSE42)
+  __m128i flips = _mm_set1_epi64x((S64)flip);
+  __m128i value = _mm_set1_epi64x((S64)(key ^ flip));
+  for (; i + 2 <= count; i += 2)
+  {
+    __m128i lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(keys + i)), flips);
+    U32 less = (U32)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(value, lanes)));
+    if (less != 0x3) return i + CountTrailingZeros32(~less);
+  }
+#elif defined(SIMD_NEON)
+  uint64x2_t flips = vdupq_n_u64(flip);
+  int64x2_t value = vdupq_n_s64((S64)(key ^ flip));
+  for (; i + 2 <= count; i += 2)
+  {
+    int64x2_t lanes = vreinterpretq_s64_u64(veorq_u64(vld1q_u64(keys + i), flips));
+    U32 less = (U32)vaddvq_u64(vshrq_n_u64(vcltq_s64(lanes, value), 63));
+    if (less != 2) return i + less;
+  }
+#endif
+  while (i < count && (S64)(keys[i] ^ flip) < (S64)(key ^ flip)) ++i;
+  return i;
+}
+
+UZ DS_BTreeSearch_S32(const S32 *keys, UZ count, S32 key) { return DS_BTreeSearch32((const U32*)keys, count, (U32)key, 0); }
+UZ DS_BTreeSearch_U32(const U32 *keys, UZ count, U32 key) { return DS_BTreeSearch32(keys, count, key, 0x80000000); }
+UZ DS_BTreeSearch_S64(const S64 *keys, UZ count, S64 key) { return DS_BTreeSearch64((const U64*)keys, count, (U64)key, 0); }
+UZ DS_BTreeSearch_U64(const U64 *keys, UZ count, U64 key) { return DS_BTreeSearch64(keys, count, key, DS_BTREE_64_SIGN); }
+
+typedef struct __DS_BTree
+{
+  MEM *mem;
+  PTR root;
+  PTR first;
+  UZ size;
+  UZ height;
+} __DS_BTree;
+
+/* Every node starts with its count, leaves follow it with the next leaf. */
+typedef struct __DS_BTreeLeaf
+{
+  UZ count;
+  PTR next;
+} __DS_BTreeLeaf;
+
+#define DS_BTreeCount(node) (*(UZ*)(node))
+#define DS_BTreeLeafKey(layout, node, i) ((U8*)(node) + (layout)->leaf_keys + (i) * (layout)->key_size)
+#define DS_BTreeLeafValue(layout, node, i) ((U8*)(node) + (layout)->leaf_values + (i) * (layout)->value_size)
+#define DS_BTreeInnerKey(layout, node, i) ((U8*)(node) + (layout)->inner_keys + (i) * (layout)->key_size)
+#define DS_BTreeChild(layout, node, i) (((PTR*)((U8*)(node) + (layout)->inner_children))[i])
+
+/* Copies entries between two leaves or within one, the ranges may overlap. */
+static void DS_BTreeMoveEntries(const DS_BTreeLayout *layout, PTR to, UZ to_index, PTR from, UZ from_index, UZ count)
+{
+  MemoryCopy(DS_BTreeLeafKey(layout, to, to_index), DS_BTreeLeafKey(layout, from, from_index), count * layout->key_size);
+  MemoryCopy(DS_BTreeLeafValue(layout, to, to_index), DS_BTreeLeafValue(layout, from, from_index), count * layout->value_size);
+}
+
+static void DS_BTreeMoveKeys(const DS_BTreeLayout *layout, PTR to, UZ to_index, PTR from, UZ from_index, UZ count)
+{
+  MemoryCopy(DS_BTreeInnerKey(layout, to, to_index), DS_BTreeInnerKey(layout, from, from_index), count * layout->key_size);
+}
+
+static void DS_BTreeMoveChildren(const DS_BTreeLayout *layout, PTR to, UZ to_index, PTR from, UZ from_index, UZ count)
+{
+  MemoryCopy(&DS_BTreeChild(layout, to, to_index), &DS_BTreeChild(layout, from, from_index), count * sizeof(PTR));
+}
+
+PTR __DS_BTreeInsert(PTR _tree, const DS_BTreeLayout *layout, DS_BTreePath *path, ConstPtr key)
+{
+  __DS_BTree *tree = _tree;
+  if (!tree->height)
+  {
+    __DS_BTreeLeaf *leaf = MEM_Allocate(tree->mem, layout->leaf_size);
+    if (!leaf) return nullptr;
+    leaf->count = 0;
+    leaf->next = nullptr;
+    tree->root = tree->first = leaf;
+    tree->height = 1;
+    path->nodes[0] = leaf;
+    path->indices[0] = 0;
+  }
+
+  /* Each full node from the leaf up splits and a new root is added when they
+     all do, so those nodes are allocated first to fail without changes. */
+  UZ splits = 0;
+  while (splits < tree->height)
+  {
+    UZ level = tree->height - 1 - splits;
+    UZ capacity = level == tree->height - 1 ? layout->leaf_capacity : layout->inner_capacity;
+    if (DS_BTreeCount(path->nodes[level]) < capacity) break;
+    splits++;
+  }
+  if (splits == tree->height && tree->height == DS_BTREE_MAX_HEIGHT) return nullptr;
+  PTR nodes[DS_BTREE_MAX_HEIGHT + 1];
+  UZ allocations = splits + (splits == tree->height);
+  for (UZ i = 0; i < allocations; ++i)
+  {
+    UZ size = i ? layout->inner_size : layout->leaf_size;
+    if (!(nodes[i] = MEM_Allocate(tree->mem, size)))
+    {
+      while (i--) MEM_Deallocate(tree->mem, nodes[i]);
+      return nullptr;
+    }
+  }
+
+  UZ level = tree->height - 1;
+  __DS_BTreeLeaf *leaf = path->nodes[level];
+  UZ index = path->indices[level];
+  DS_BTreeMoveEntries(layout, leaf, index + 1, leaf, index, leaf->count - index);
+  MemoryCopy(DS_BTreeLeafKey(layout, leaf, index), key, layout->key_size);
+  leaf->count++;
+  tree->size++;
+  PTR slot = DS_BTreeLeafValue(layout, leaf, index);
+  if (!splits) return slot;
+
+  /* Splitting the last leaf while appending leaves it full, so ascending
+     inserts fill the leaves. */
+  __DS_BTreeLeaf *right = nodes[0];
+  UZ middle = !leaf->next && index == layout->leaf_capacity ? layout->leaf_capacity : leaf->count / 2;
+  right->count = leaf->count - middle;
+  right->next = leaf->next;
+  DS_BTreeMoveEntries(layout, right, 0, leaf, middle, right->count);
+  leaf->count = middle;
+  leaf->next = right;
+  if (index >= middle) slot = DS_BTreeLeafValue(layout, right, index - middle);
+  PTR separator = DS_BTreeLeafKey(layout, right, 0);
+  PTR sibling = right;
+
+  for (UZ i = 1;; ++i)
+  {
+    if (!level)
+    {
+      PTR root = nodes[i];
+      DS_BTreeCount(root) = 1;
+      MemoryCopy(DS_BTreeInnerKey(layout, root, 0), separator, layout->key_size);
+      DS_BTreeChild(layout, root, 0) = tree->root;
+      DS_BTreeChild(layout, root, 1) = sibling;
+      tree->root = root;
+      tree->height++;
+      return slot;
+    }
+
+    level--;
+    PTR node = path->nodes[level];
+    UZ count = DS_BTreeCount(node);
+    index = path->indices[level];
+    DS_BTreeMoveKeys(layout, node, index + 1, node, index, count - index);
+    DS_BTreeMoveChildren(layout, node, index + 2, node, index + 1, count - index);
+    MemoryCopy(DS_BTreeInnerKey(layout, node, index), separator, layout->key_size);
+    DS_BTreeChild(layout, node, index + 1) = sibling;
+    DS_BTreeCount(node) = ++count;
+    if (i == splits) return slot;
+
+    /* the middle key moves up and the keys after it to the new node */
+    PTR split = nodes[i];
+    middle = count / 2;
+    DS_BTreeCount(split) = count - middle - 1;
+    DS_BTreeMoveKeys(layout, split, 0, node, middle + 1, count - middle - 1);
+    DS_BTreeMoveChildren(layout, split, 0, node, middle + 1, count - middle);
+    DS_BTreeCount(node) = middle;
+    separator = DS_BTreeInnerKey(layout, node, middle);
+    sibling = split;
+  }
+}
+
+void __DS_BTreeRemove(PTR _tree, const DS_BTreeLayout *layout, DS_BTreePath *path)
+{
+  __DS_BTree *tree = _tree;
+  UZ level = tree->height - 1;
+  __DS_BTreeLeaf *leaf = path->nodes[level];
+  UZ index = path->indices[level];
+  DS_BTreeMoveEntries(layout, leaf, index, leaf, index + 1, leaf->count - index - 1);
+  leaf->count--;
+  tree->size--;
+
+  /* A node that falls below half its capacity borrows an entry from a sibling
+     next to it, or merges with that sibling when it has none to spare. */
+  for (PTR node = leaf; level; --level)
+  {
+    bool is_leaf = level == tree->height - 1;
+    UZ minimum = (is_leaf ? layout->leaf_capacity : layout->inner_capacity) / 2;
+    if (DS_BTreeCount(node) >= minimum) return;
+
+    PTR parent = path->nodes[level - 1];
+    UZ separator = path->indices[level - 1] ? path->indices[level - 1] - 1 : 0;
+    PTR left = DS_BTreeChild(layout, parent, separator);
+    PTR right = DS_BTreeChild(layout, parent, separator + 1);
+    UZ left_count = DS_BTreeCount(left), right_count = DS_BTreeCount(right);
+    PTR separator_key = DS_BTreeInnerKey(layout, parent, separator);
+
+    if (node == right && left_count > minimum)
+    {
+      if (is_leaf)
+      {
+        DS_BTreeMoveEntries(layout, right, 1, right, 0, right_count);
+        DS_BTreeMoveEntries(layout, right, 0, left, left_count - 1, 1);
+        MemoryCopy(separator_key, DS_BTreeLeafKey(layout, right, 0), layout->key_size);
+      }
+      else
+      {
+        DS_BTreeMoveKeys(layout, right, 1, right, 0, right_count);
+        DS_BTreeMoveChildren(layout, right, 1, right, 0, right_count + 1);
+        MemoryCopy(DS_BTreeInnerKey(layout, right, 0), separator_key, layout->key_size);
+        DS_BTreeChild(layout, right, 0) = DS_BTreeChild(layout, left, left_count);
+        MemoryCopy(separator_key, DS_BTreeInnerKey(layout, left, left_count - 1), layout->key_size);
+      }
+      DS_BTreeCount(left)--;
+      DS_BTreeCount(right)++;
+      return;
+    }
+    if (node == left && right_count > minimum)
+    {
+      if (is_leaf)
+      {
+        DS_BTreeMoveEntries(layout, left, left_count, right, 0, 1);
+        DS_BTreeMoveEntries(layout, right, 0, right, 1, right_count - 1);
+        MemoryCopy(separator_key, DS_BTreeLeafKey(layout, right, 0), layout->key_size);
+      }
+      else
+      {
+        MemoryCopy(DS_BTreeInnerKey(layout, left, left_count), separator_key, layout->key_size);
+        DS_BTreeChild(layout, left, left_count + 1) = DS_BTreeChild(layout, right, 0);
+        MemoryCopy(separator_key, DS_BTreeInnerKey(layout, right, 0), layout->key_size);
+        DS_BTreeMoveKeys(layout, right, 0, right, 1, right_count - 1);
+        DS_BTreeMoveChildren(layout, right, 0, right, 1, right_count);
+      }
+      DS_BTreeCount(left)++;
+      DS_BTreeCount(right)--;
+      return;
+    }
+
+    if (is_leaf)
+    {
+      DS_BTreeMoveEntries(layout, left, left_count, right, 0, right_count);
+      ((__DS_BTreeLeaf*)left)->next = ((__DS_BTreeLeaf*)right)->next;
+      DS_BTreeCount(left) = left_count + right_count;
+    }
+    else
+    {
+      MemoryCopy(DS_BTreeInnerKey(layout, left, left_count), separator_key, layout->key_size);
+      DS_BTreeMoveKeys(layout, left, left_count + 1, right, 0, right_count);
+      DS_BTreeMoveChildren(layout, left, left_count + 1, right, 0, right_count + 1);
+      DS_BTreeCount(left) = left_count + right_count + 1;
+    }
+    MEM_Deallocate(tree->mem, right);
+    UZ parent_count = DS_BTreeCount(parent);
+    DS_BTreeMoveKeys(layout, parent, separator, parent, separator + 1, parent_count - separator - 1);
+    DS_BTreeMoveChildren(layout, parent, separator + 1, parent, separator + 2, parent_count - separator - 1);
+    DS_BTreeCount(parent) = parent_count - 1;
+    node = parent;
+  }
+
+  /* the root is removed when it is an empty leaf or an inner node with one child */
+  PTR root = tree->root;
+  if (DS_BTreeCount(root)) return;
+  if (tree->height == 1)
+  {
+    tree->root = tree->first = nullptr;
+  }
+  else
+  {
+    tree->root = DS_BTreeChild(layout, root, 0);
+  }
+  tree->height--;
+  MEM_Deallocate(tree->mem, root);
+}
+
+static void DS_BTreeFreeNode(MEM *mem, const DS_BTreeLayout *layout, PTR node, UZ height)
+{
+  if (height > 1)
+  {
+    for (UZ i = 0; i <= DS_BTreeCount(node); ++i)
+    {
+      DS_BTreeFreeNode(mem, layout, DS_BTreeChild(layout, node, i), height - 1);
+    }
+  }
+  MEM_Deallocate(mem, node);
+}
+
+void __DS_BTreeClear(PTR _tree, const DS_BTreeLayout *layout)
+{
+  __DS_BTree *tree = _tree;
+  if (tree->root) DS_BTreeFreeNode(tree->mem, layout, tree->root, tree->height);
+  tree->root = tree->first = nullptr;
+  tree->size = 0;
+  tree->height = 0;
+}
+
+#define DS_ROARING_BITMAP_SIZE 4096
+#define DS_ROARING_MAGIC 0x31524244
+#define DS_ROARING_OR 0
+#define DS_ROARING_AND 1
+#define DS_ROARING_ANDNOT 2
+
+typedef struct DS_RoaringDescriptor
+{
+  U16 key;
+  U8 type;
+  U8 reserved;
+  U32 cardinality;
+  U32 size;
+  U32 offset;
+} DS_RoaringDescriptor;
+
+#define DS_RoaringBits(c) ((DS_BitField) { (U64*)(c)->data, 1 << 16 })
+
+/* Returns the index of the first value not less than the given one, or the count. */
+static U32 DS_RoaringLowerBound(const U16 *values, U32 count, U16 value)
+{
+  U32 low = 0;
+  for (U32 high = count; low < high;)
+  {
+    U32 middle = (low + high) / 2;
+    if (values[middle] < value) low = middle + 1;
+    else high = middle;
+  }
+  return low;
+}
+
+static bool DS_RoaringContainerContains(const DS_RoaringContainer *c, U16 value)
+{
+  if (c->type == DS_ROARING_BITMAP) return DS_BitFieldGet(DS_RoaringBits(c), value);
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    U32 i = DS_RoaringLowerBound(c->data, c->size, value);
+    return i < c->size && c->data[i] == value;
+  }
+  /* finds the last run starting at or before the value */
+  U32 low = 0;
+  for (U32 high = c->size / 2; low < high;)
+  {
+    U32 middle = (low + high) / 2;
+    if (c->data[middle * 2] <= value) low = middle + 1;
+    else high = middle;
+  }
+  return low && value - c->data[low * 2 - 2] <= c->data[low * 2 - 1];
+}
+
+/* Replaces the data of the container, which it owns unless it belongs to a view. */
+static void DS_RoaringReplace(MEM *mem, DS_RoaringContainer *c, U16 *data, U32 size, U32 capacity, U8 type)
+{
+  if (c->capacity) MEM_Deallocate(mem, c->data);
+  c->data = data;
+  c->size = size;
+  c->capacity = capacity;
+  c->type = type;
+}
+
+static bool DS_RoaringToBitmap(MEM *mem, DS_RoaringContainer *c)
+{
+  if (c->type == DS_ROARING_BITMAP) return true;
+  U16 *words = MEM_AllocateZero(mem, DS_ROARING_BITMAP_SIZE * sizeof(U16));
+  if (!words) return false;
+  DS_BitField bits = { (U64*)words, 1 << 16 };
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    for (U32 i = 0; i < c->size; ++i) DS_BitFieldSet(bits, c->data[i]);
+  }
+  else for (U32 i = 0; i < c->size; i += 2)
+  {
+    DS_BitFieldSetRange(bits, c->data[i], (UZ)c->data[i] + c->data[i + 1] + 1);
+  }
+  DS_RoaringReplace(mem, c, words, DS_ROARING_BITMAP_SIZE, DS_ROARING_BITMAP_SIZE, DS_ROARING_BITMAP);
+  return true;
+}
+
+/* Converts a container with at most DS_ROARING_ARRAY_MAX values into an array. */
+static bool DS_RoaringToArray(MEM *mem, DS_RoaringContainer *c)
+{
+  if (c->type == DS_ROARING_ARRAY) return true;
+  U32 capacity = Max(c->cardinality, 1u), size = 0;
+  U16 *values = MEM_Allocate(mem, capacity * sizeof(U16));
+  if (!values) return false;
+  if (c->type == DS_ROARING_BITMAP)
+  {
+    const U64 *words = (const U64*)c->data;
+    for (U32 i = 0; i < DS_ROARING_BITMAP_SIZE / 4; ++i)
+    {
+      for (U64 word = words[i]; word; word &= word - 1)
+      {
+        values[size++] = (U16)((i << 6) + CountTrailingZeros64(word));
+      }
+    }
+  }
+  else for (U32 i = 0; i < c->size; i += 2)
+  {
+    for (U32 value = c->data[i], end = value + c->data[i + 1]; value <= end; ++value) values[size++] = (U16)value;
+  }
+  DS_RoaringReplace(mem, c, values, size, capacity, DS_ROARING_ARRAY);
+  return true;
+}
+
+static U32 DS_RoaringCountRuns(const DS_RoaringContainer *c)
+{
+  U32 runs = 0;
+  if (c->type == DS_ROARING_RUN) return c->size / 2;
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    for (U32 i = 0; i < c->size; ++i) runs += !i || c->data[i] != c->data[i - 1] + 1;
+    return runs;
+  }
+  /* a run starts at every set bit following a clear one */
+  const U64 *words = (const U64*)c->data;
+  for (U32 i = 0, carry = 0; i < DS_ROARING_BITMAP_SIZE / 4; ++i)
+  {
+    runs += PopCount64(words[i] & ~(words[i] << 1 | carry));
+    carry = (U32)(words[i] >> 63);
+  }
+  return runs;
+}
+
+static bool DS_RoaringToRun(MEM *mem, DS_RoaringContainer *c, U32 runs)
+{
+  U16 *pairs = MEM_Allocate(mem, runs * 2 * sizeof(U16));
+  if (!pairs) return false;
+  U32 size = 0;
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    for (U32 i = 0; i < c->size; ++i)
+    {
+      if (size && c->data[i] == pairs[size - 2] + pairs[size - 1] + 1) ++pairs[size - 1];
+      else pairs[size++] = c->data[i], pairs[size++] = 0;
+    }
+  }
+  else
+  {
+    DS_BitField bits = DS_RoaringBits(c);
+    for (UZ start = DS_BitFieldFindSet(bits, 0); start < bits.width;)
+    {
+      UZ end = DS_BitFieldFindClear(bits, start);
+      pairs[size++] = (U16)start;
+      pairs[size++] = (U16)(end - start - 1);
+      start = DS_BitFieldFindSet(bits, end);
+    }
+  }
+  DS_RoaringReplace(mem, c, pairs, size, size, DS_ROARING_RUN);
+  return true;
+}
+
+/* Turns a run container back into an array or a bitmap before it changes. */
+static bool DS_RoaringUnpack(MEM *mem, DS_RoaringContainer *c)
+{
+  if (c->type != DS_ROARING_RUN) return true;
+  return c->cardinality < DS_ROARING_ARRAY_MAX ? DS_RoaringToArray(mem, c) : DS_RoaringToBitmap(mem, c);
+}
+
+/* Returns the index of the first container with a key not less than the given one. */
+static U32 DS_RoaringFindKey(const DS_Roaring *bitmap, U16 key)
+{
+  U32 low = 0;
+  for (U32 high = bitmap->count; low < high;)
+  {
+    U32 middle = (low + high) / 2;
+    if (bitmap->containers[middle].key < key) low = middle + 1;
+    else high = middle;
+  }
+  return low;
+}
+
+static DS_RoaringContainer *DS_RoaringInsertContainer(DS_Roaring *bitmap, U32 index, U16 key)
+{
+  if (bitmap->count == bitmap->capacity)
+  {
+    U32 capacity = bitmap->capacity ? bitmap->capacity * 2 : 4;
+    DS_RoaringContainer *containers = MEM_Reallocate(bitmap->mem, bitmap->containers, capacity * sizeof(DS_RoaringContainer));
+    if (!containers) return nullptr;
+    bitmap->containers = containers;
+    bitmap->capacity = capacity;
+  }
+  DS_RoaringContainer *c = bitmap->containers + index;
+  MemoryCopy(c + 1, c, (bitmap->count - index) * sizeof(DS_RoaringContainer));
+  MemoryZeroStruct(c);
+  c->key = key;
+  bitmap->count++;
+  return c;
+}
+
+static void DS_RoaringRemoveContainer(DS_Roaring *bitmap, U32 index)
+{
+  DS_RoaringContainer *c = bitmap->containers + index;
+  if (c->capacity) MEM_Deallocate(bitmap->mem, c->data);
+  MemoryCopy(c, c + 1, (bitmap->count - index - 1) * sizeof(DS_RoaringContainer));
+  bitmap->count--;
+}
+
+void DS_RoaringFree(DS_Roaring *bitmap)
+{
+  for (U32 i = 0; i < bitmap->count; ++i)
+  {
+    if (bitmap->containers[i].capacity) MEM_Deallocate(bitmap->mem, bitmap->containers[i].data);
+  }
+  if (bitmap->containers) MEM_Deallocate(bitmap->mem, bitmap->containers);
+  MemoryZeroStruct(bitmap);
+}
+
+bool DS_RoaringAdd(DS_Roaring *bitmap, U32 value)
+{
+  if (bitmap->view) return false;
+  U16 key = (U16)(value >> 16), low = (U16)value;
+  U32 index = DS_RoaringFindKey(bitmap, key);
+  DS_RoaringContainer *c = bitmap->containers + index;
+  if (index == bitmap->count || c->key != key)
+  {
+    c = DS_RoaringInsertContainer(bitmap, index, key);
+    if (!c) return false;
+  }
+  else if (DS_RoaringContainerContains(c, low)) return true;
+  if (!DS_RoaringUnpack(bitmap->mem, c) || (c->type == DS_ROARING_ARRAY && c->size == DS_ROARING_ARRAY_MAX && !DS_RoaringToBitmap(bitmap->mem, c)))
+  {
+    if (!c->cardinality) DS_RoaringRemoveContainer(bitmap, index);
+    return false;
+  }
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    if (c->size == c->capacity)
+    {
+      U32 capacity = Min(Max(c->capacity * 2, 4u), (U32)DS_ROARING_ARRAY_MAX);
+      U16 *values = MEM_Reallocate(bitmap->mem, c->data, capacity * sizeof(U16));
+      if (!values)
+      {
+        if (!c->cardinality) DS_RoaringRemoveContainer(bitmap, index);
+        return false;
+      }
+      c->data = values;
+      c->capacity = capacity;
+    }
+    U32 i = DS_RoaringLowerBound(c->data, c->size, low);
+    MemoryCopy(c->data + i + 1, c->data + i, (c->size - i) * sizeof(U16));
+    c->data[i] = low;
+    c->size++;
+  }
+  else DS_BitFieldSet(DS_RoaringBits(c), low);
+  c->cardinality++;
+  return true;
+}
+
+bool DS_RoaringRemove(DS_Roaring *bitmap, U32 value)
+{
+  if (bitmap->view) return false;
+  U16 key = (U16)(value >> 16), low = (U16)value;
+  U32 index = DS_RoaringFindKey(bitmap, key);
+  DS_RoaringContainer *c = bitmap->containers + index;
+  if (index == bitmap->count || c->key != key || !DS_RoaringContainerContains(c, low)) return false;
+  if (c->cardinality == 1)
+  {
+    DS_RoaringRemoveContainer(bitmap, index);
+    return true;
+  }
+  if (!DS_RoaringUnpack(bitmap->mem, c)) return false;
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    U32 i = DS_RoaringLowerBound(c->data, c->size, low);
+    MemoryCopy(c->data + i, c->data + i + 1, (c->size - i - 1) * sizeof(U16));
+    c->size--;
+  }
+  else DS_BitFieldClear(DS_RoaringBits(c), low);
+  /* a bitmap shrinking back to the array limit becomes an array if the allocation works */
+  if (--c->cardinality == DS_ROARING_ARRAY_MAX) DS_RoaringToArray(bitmap->mem, c);
+  return true;
+}
+
+bool DS_RoaringContains(const DS_Roaring *bitmap, U32 value)
+{
+  U32 index = DS_RoaringFindKey(bitmap, (U16)(value >> 16));
+  const DS_RoaringContainer *c = bitmap->containers + index;
+  return index < bitmap->count && c->key == (U16)(value >> 16) && DS_RoaringContainerContains(c, (U16)value);
+}
+
+U64 DS_RoaringCount(const DS_Roaring *bitmap)
+{
+  U64 count = 0;
+  for (U32 i = 0; i < bitmap->count; ++i) count += bitmap->containers[i].cardinality;
+  return count;
+}
+
+bool DS_RoaringOptimize(DS_Roaring *bitmap)
+{
+  if (bitmap->view) return false;
+  for (U32 i = 0; i < bitmap->count; ++i)
+  {
+    DS_RoaringContainer *c = bitmap->containers + i;
+    if (c->type == DS_ROARING_RUN) continue;
+    U32 runs = DS_RoaringCountRuns(c);
+    if (runs * 2 < c->size && !DS_RoaringToRun(bitmap->mem, c, runs)) return false;
+  }
+  return true;
+}
+
+static bool DS_RoaringCopyContainer(MEM *mem, DS_RoaringContainer *out, const DS_RoaringContainer *c)
+{
+  *out = *c;
+  out->capacity = c->size;
+  out->data = MEM_Allocate(mem, c->size * sizeof(U16));
+  if (!out->data) return false;
+  MemoryCopy(out->data, c->data, c->size * sizeof(U16));
+  return true;
+}
+
+/* Keeps the values of an array found (or not found) in the other container. */
+static bool DS_RoaringFilter(MEM *mem, DS_RoaringContainer *out, const DS_RoaringContainer *array, const DS_RoaringContainer *other, bool found)
+{
+  out->data = MEM_Allocate(mem, array->size * sizeof(U16));
+  if (!out->data) return false;
+  out->capacity = array->size;
+  for (U32 i = 0; i < array->size; ++i)
+  {
+    out->data[out->size] = array->data[i];
+    out->size += DS_RoaringContainerContains(other, array->data[i]) == found;
+  }
+  out->cardinality = out->size;
+  return true;
+}
+
+/* Merges two sorted arrays, keeping the values selected by the operation. */
+static bool DS_RoaringMerge(MEM *mem, DS_RoaringContainer *out, const DS_RoaringContainer *a, const DS_RoaringContainer *b, U32 op)
+{
+  U32 capacity = op == DS_ROARING_OR ? a->size + b->size : a->size;
+  out->data = MEM_Allocate(mem, capacity * sizeof(U16));
+  if (!out->data) return false;
+  out->capacity = capacity;
+  U32 i = 0, j = 0;
+  while (i < a->size && j < b->size)
+  {
+    U16 x = a->data[i], y = b->data[j];
+    if (x == y && op != DS_ROARING_ANDNOT) out->data[out->size++] = x;
+    if (x < y && op != DS_ROARING_AND) out->data[out->size++] = x;
+    if (y < x && op == DS_ROARING_OR) out->data[out->size++] = y;
+    i += x <= y;
+    j += y <= x;
+  }
+  if (op != DS_ROARING_AND) while (i < a->size) out->data[out->size++] = a->data[i++];
+  if (op == DS_ROARING_OR) while (j < b->size) out->data[out->size++] = b->data[j++];
+  out->cardinality = out->size;
+  return out->size <= DS_ROARING_ARRAY_MAX || DS_RoaringToBitmap(mem, out);
+}
+
+static bool DS_RoaringCombineContainers(MEM *mem, DS_RoaringContainer *out, const DS_RoaringContainer *a, const DS_RoaringContainer *b, U32 op)
+{
+  MemoryZeroStruct(out);
+  out->key = a->key;
+  if (a->type == DS_ROARING_ARRAY && b->type == DS_ROARING_ARRAY) return DS_RoaringMerge(mem, out, a, b, op);
+  if (op == DS_ROARING_AND && a->type == DS_ROARING_ARRAY) return DS_RoaringFilter(mem, out, a, b, true);
+  if (op == DS_ROARING_AND && b->type == DS_ROARING_ARRAY) return DS_RoaringFilter(mem, out, b, a, true);
+  if (op == DS_ROARING_ANDNOT && a->type == DS_ROARING_ARRAY) return DS_RoaringFilter(mem, out, a, b, false);
+
+  /* everything else is computed on a bitmap copy of the left container */
+  if (!DS_RoaringCopyContainer(mem, out, a) || !DS_RoaringToBitmap(mem, out)) return false;
+  DS_BitField bits = DS_RoaringBits(out);
+  if (b->type == DS_ROARING_BITMAP)
+  {
+    if (op == DS_ROARING_OR) DS_BitFieldOr(bits, DS_RoaringBits(b));
+    if (op == DS_ROARING_AND) DS_BitFieldAnd(bits, DS_RoaringBits(b));
+    if (op == DS_ROARING_ANDNOT) DS_BitFieldAndNot(bits, DS_RoaringBits(b));
+  }
+  else if (b->type == DS_ROARING_ARRAY)
+  {
+    for (U32 i = 0; i < b->size; ++i)
+    {
+      if (op == DS_ROARING_OR) DS_BitFieldSet(bits, b->data[i]);
+      else DS_BitFieldClear(bits, b->data[i]);
+    }
+  }
+  else
+  {
+    /* intersecting with runs clears the gaps between them */
+    UZ previous = 0;
+    for (U32 i = 0; i < b->size; i += 2)
+    {
+      UZ start = b->data[i], end = start + b->data[i + 1] + 1;
+      if (op == DS_ROARING_OR) DS_BitFieldSetRange(bits, start, end);
+      if (op == DS_ROARING_AND) DS_BitFieldClearRange(bits, previous, start);
+      if (op == DS_ROARING_ANDNOT) DS_BitFieldClearRange(bits, start, end);
+      previous = end;
+    }
+    if (op == DS_ROARING_AND) DS_BitFieldClearRange(bits, previous, bits.width);
+  }
+  out->cardinality = (U32)DS_BitFieldCount(bits);
+  if (out->cardinality <= DS_ROARING_ARRAY_MAX) return DS_RoaringToArray(mem, out);
+  return true;
+}
+
+static bool DS_RoaringAppend(DS_Roaring *bitmap, DS_RoaringContainer *c)
+{
+  if (!c->cardinality)
+  {
+    if (c->capacity) MEM_Deallocate(bitmap->mem, c->data);
+    return true;
+  }
+  DS_RoaringContainer *slot = DS_RoaringInsertContainer(bitmap, bitmap->count, c->key);
+  if (!slot)
+  {
+    if (c->capacity) MEM_Deallocate(bitmap->mem, c->data);
+    return false;
+  }
+  *slot = *c;
+  return true;
+}
+
+static bool DS_RoaringCombine(DS_Roaring *result, const DS_Roaring *a, const DS_Roaring *b, U32 op)
+{
+  if (result->view || result->count || result == a || result == b) return false;
+  MEM *mem = result->mem;
+  for (U32 i = 0, j = 0; i < a->count || j < b->count;)
+  {
+    const DS_RoaringContainer *x = i < a->count ? a->containers + i : nullptr;
+    const DS_RoaringContainer *y = j < b->count ? b->containers + j : nullptr;
+    DS_RoaringContainer c = { 0 };
+    bool success = true;
+    if (x && (!y || x->key < y->key))
+    {
+      if (op != DS_ROARING_AND) success = DS_RoaringCopyContainer(mem, &c, x);
+      ++i;
+    }
+    else if (!x || y->key < x->key)
+    {
+      if (op == DS_ROARING_OR) success = DS_RoaringCopyContainer(mem, &c, y);
+      ++j;
+    }
+    else
+    {
+      success = DS_RoaringCombineContainers(mem, &c, x, y, op);
+      ++i, ++j;
+    }
+    if (!success || !DS_RoaringAppend(result, &c))
+    {
+      if (!success && c.capacity) MEM_Deallocate(mem, c.data);
+      DS_RoaringFree(result);
+      result->mem = mem;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DS_RoaringOr(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right)
+{
+  return DS_RoaringCombine(result, left, right, DS_ROARING_OR);
+}
+
+bool DS_RoaringAnd(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right)
+{
+  return DS_RoaringCombine(result, left, right, DS_ROARING_AND);
+}
+
+bool DS_RoaringAndNot(DS_Roaring *result, const DS_Roaring *left, const DS_Roaring *right)
+{
+  return DS_RoaringCombine(result, left, right, DS_ROARING_ANDNOT);
+}
+
+UZ DS_RoaringSerializedSize(const DS_Roaring *bitmap)
+{
+  UZ size = 2 * sizeof(U32) + bitmap->count * sizeof(DS_RoaringDescriptor);
+  for (U32 i = 0; i < bitmap->count; ++i) size += MEM_FastAlignUp(bitmap->containers[i].size * sizeof(U16), 8);
+  return size;
+}
+
+UZ DS_RoaringSerialize(const DS_Roaring *bitmap, U8 *buffer, UZ capacity)
+{
+  UZ size = DS_RoaringSerializedSize(bitmap);
+  if (size > capacity || size > MAX_U32) return 0;
+  U32 header[2] = { DS_ROARING_MAGIC, bitmap->count };
+  MemoryCopy(buffer, header, sizeof(header));
+  UZ offset = sizeof(header) + bitmap->count * sizeof(DS_RoaringDescriptor);
+  for (U32 i = 0; i < bitmap->count; ++i)
+  {
+    const DS_RoaringContainer *c = bitmap->containers + i;
+    DS_RoaringDescriptor descriptor = { c->key, c->type, 0, c->cardinality, c->size, (U32)offset };
+    MemoryCopy(buffer + sizeof(header) + i * sizeof(descriptor), &descriptor, sizeof(descriptor));
+    UZ bytes = c->size * sizeof(U16);
+    MemoryCopy(buffer + offset, c->data, bytes);
+    memset(buffer + offset + bytes, 0, MEM_FastAlignUp(bytes, 8) - bytes);
+    offset += MEM_FastAlignUp(bytes, 8);
+  }
+  return size;
+}
+
+/* Checks that the values of a serialized container are sorted and match its cardinality. */
+static bool DS_RoaringValidate(const DS_RoaringContainer *c)
+{
+  if (c->type == DS_ROARING_BITMAP) return DS_BitFieldCount(DS_RoaringBits(c)) == c->cardinality;
+  if (c->type == DS_ROARING_ARRAY)
+  {
+    for (U32 i = 1; i < c->size; ++i)
+    {
+      if (c->data[i] <= c->data[i - 1]) return false;
+    }
+    return true;
+  }
+  U32 count = 0;
+  for (U32 i = 0, end = 0; i < c->size; i += 2)
+  {
+    if (c->data[i] < end || c->data[i] + c->data[i + 1] > MAX_U16) return false;
+    end = c->data[i] + c->data[i + 1] + 1;
+    count += c->data[i + 1] + 1;
+  }
+  return count == c->cardinality;
+}
+
+bool DS_RoaringView(DS_Roaring *bitmap, STR data)
+{
+  U32 header[2];
+  if (bitmap->count || bitmap->view || data.size < sizeof(header) || ((UP)data.str & 7)) return false;
+  MemoryCopy(header, data.str, sizeof(header));
+  if (header[0] != DS_ROARING_MAGIC || header[1] > (1 << 16)) return false;
+  if ((data.size - sizeof(header)) / sizeof(DS_RoaringDescriptor) < header[1]) return false;
+  DS_RoaringContainer *containers = MEM_Allocate(bitmap->mem, Max(header[1], 1u) * sizeof(DS_RoaringContainer));
+  if (!containers) return false;
+  for (U32 i = 0; i < header[1]; ++i)
+  {
+    DS_RoaringDescriptor d;
+    MemoryCopy(&d, data.str + sizeof(header) + i * sizeof(d), sizeof(d));
+    bool valid = (d.offset & 7) == 0 && d.offset <= data.size && d.size <= (data.size - d.offset) / sizeof(U16) && d.cardinality;
+    valid = valid && (!i || d.key > containers[i - 1].key);
+    if (d.type == DS_ROARING_ARRAY) valid = valid && d.size == d.cardinality && d.size <= DS_ROARING_ARRAY_MAX;
+    else if (d.type == DS_ROARING_BITMAP) valid = valid && d.size == DS_ROARING_BITMAP_SIZE;
+    else valid = valid && d.type == DS_ROARING_RUN && !(d.size & 1) && d.cardinality <= (1 << 16);
+    containers[i] = (DS_RoaringContainer) { (U16*)(data.str + d.offset), d.size, 0, d.cardinality, d.key, d.type };
+    if (!valid || !DS_RoaringValidate(containers + i))
+    {
+      MEM_Deallocate(bitmap->mem, containers);
+      return false;
+    }
+  }
+  bitmap->containers = containers;
+  bitmap->count = bitmap->capacity = header[1];
+  bitmap->view = true;
+  return true;
+}
+
+#define DS_RADIX_MIN_CHUNK (1 << 16)
+#define DS_RADIX_MAX_THREADS 64
+
+typedef UZ DS_RadixCounts[8][256];
+
+/*
+ * The values are encoded in place as unsigned integers in the same order and
+ * decoded after sorting: signed values flip their sign bit, floating point
+ * values flip it when they are positive and every bit when they are negative.
+ * The counts of every byte are gathered in one pass, after which each byte
+ * that varies is a stable counting pass between the values and the buffer.
+ */
+#define DS_RadixDefine(U, BITS)                                                                    \
+static void Glue(DS_RadixEncode, BITS)(PTR _items, UZ count, U32 kind, bool decode)                \
+{                                                                                                  \
+  U *items = _items, sign = (U)((U)1 << (BITS - 1));                                               \
+  if (kind == DS_RADIX_SIGNED)                                                                     \
+  {                                                                                                \
+    for (UZ i = 0; i < count; ++i) items[i] ^= sign;                                               \
+  }                                                                                                \
+  else if (kind == DS_RADIX_FLOAT)                                                                 \
+  {                                                                                                \
+    for (UZ i = 0; i < count; ++i)                                                                 \
+    {                                                                                              \
+      bool negative = decode ? !(items[i] & sign) : (items[i] & sign) != 0;                        \
+      items[i] ^= negative ? (U)~(U)0 : sign;                                                      \
+    }                                                                                              \
+  }                                                                                                \
+}                                                                                                  \
+static void Glue(DS_RadixCount, BITS)(ConstPtr _items, UZ count, DS_RadixCounts counts)            \
+{                                                                                                  \
+  const U *items = _items;                                                                         \
+  for (UZ i = 0; i < count; ++i)                                                                   \
+  {                                                                                                \
+    for (U32 digit = 0; digit < BITS / 8; ++digit)                                                 \
+    {                                                                                              \
+      counts[digit][(items[i] >> (digit * 8)) & 0xFF]++;                                           \
+    }                                                                                              \
+  }                                                                                                \
+}                                                                                                  \
+static void Glue(DS_RadixScatter, BITS)(ConstPtr _from, PTR _to, UZ count, U32 digit, UZ *offsets) \
+{                                                                                                  \
+  const U *from = _from;                                                                           \
+  U *to = _to;                                                                                     \
+  for (UZ i = 0; i < count; ++i)                                                                   \
+  {                                                                                                \
+    to[offsets[(from[i] >> (digit * 8)) & 0xFF]++] = from[i];                                      \
+  }                                                                                                \
+}
+
+DS_RadixDefine(U8, 8)
+DS_RadixDefine(U16, 16)
+DS_RadixDefine(U32, 32)
+DS_RadixDefine(U64, 64)
+
+typedef struct DS_RadixType
+{
+  void (*encode)(PTR items, UZ count, U32 kind, bool decode);
+  void (*count)(ConstPtr items, UZ count, DS_RadixCounts counts);
+  void (*scatter)(ConstPtr from, PTR to, UZ count, U32 digit, UZ *offsets);
+} DS_RadixType;
+
+static const DS_RadixType DS_RADIX_TYPES[] =
+{
+  { DS_RadixEncode8, DS_RadixCount8, DS_RadixScatter8 },
+  { DS_RadixEncode16, DS_RadixCount16, DS_RadixScatter16 },
+  { DS_RadixEncode32, DS_RadixCount32, DS_RadixScatter32 },
+  { DS_RadixEncode64, DS_RadixCount64, DS_RadixScatter64 },
+};
+
+/* Sorts encoded values on their lowest bytes, leaving them in the values or
+   the buffer as given by the target. */
+static void DS_RadixSortRange(const DS_RadixType *type, UZ size, U8 *items, U8 *buffer, UZ count, U32 digits, U8 *target)
+{
+  DS_RadixCounts counts = { 0 };
+  type->count(items, count, counts);
+  U8 *from = items, *to = buffer;
+  for (U32 digit = 0; digit < digits; ++digit)
+  {
+    UZ offsets[256], offset = 0;
+    for (U32 i = 0; i < 256; ++i)
+    {
+      if (counts[digit][i] == count) break;
+      offsets[i] = offset;
+      offset += counts[digit][i];
+    }
+    if (offset < count) continue;
+    type->scatter(from, to, count, digit, offsets);
+    U8 *swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from != target) MemoryCopy(target, from, count * size);
+}
+
+typedef struct DS_RadixTask
+{
+  const DS_RadixType *type;
+  U8 *items;
+  U8 *buffer;
+  UZ size;
+  UZ begin;
+  UZ end;
+  U32 kind;
+  U32 step;
+  U32 digit;
+  const UZ *starts;
+  UZ (*counts)[256];
+} DS_RadixTask;
+
+static U32 OSAPI DS_RadixRunTask(void *param)
+{
+  DS_RadixTask *task = param;
+  const DS_RadixType *type = task->type;
+  U8 *items = task->items + task->begin * task->size;
+  UZ count = task->end - task->begin;
+  if (task->step == 0)
+  {
+    type->encode(items, count, task->kind, false);
+    type->count(items, count, task->counts);
+  }
+  else if (task->step == 1)
+  {
+    type->scatter(items, task->buffer, count, task->digit, task->counts[task->digit]);
+  }
+  else
+  {
+    /* the range holds whole partitions of the buffer, each sorted on its own */
+    for (UZ begin = task->begin; begin < task->end;)
+    {
+      UZ end = begin;
+      for (U32 i = 0; i < 256; ++i)
+      {
+        if (task->starts[i] > begin) { end = task->starts[i]; break; }
+      }
+      if (end == begin) end = task->end;
+      U8 *from = task->buffer + begin * task->size, *to = task->items + begin * task->size;
+      DS_RadixSortRange(type, task->size, from, to, end - begin, task->digit, to);
+      begin = end;
+    }
+    type->encode(items, count, task->kind, true);
+  }
+  return 0;
+}
+
+/* Runs every task, on new threads where possible and on the calling thread otherwise. */
+static void DS_RadixRun(DS_RadixTask *tasks, OS_Thread *threads, U32 count, U32 step)
+{
+  for (U32 i = 0; i < count; ++i) tasks[i].step = step;
+  for (U32 i = 1; i < count; ++i) threads[i] = OS_ThreadCreate(DS_RadixRunTask, tasks + i);
+  DS_RadixRunTask(tasks);
+  for (U32 i = 1; i < count; ++i)
+  {
+    if (threads[i]) OS_ThreadJoin(threads[i], null);
+    else DS_RadixRunTask(tasks + i);
+  }
+}
+
+bool __DS_RadixSort(MEM *mem, PTR items, UZ count, UZ size, U32 kind, U32 threads)
+{
+  if (count < 2) return true;
+  if (size != 1 && size != 2 && size != 4 && size != 8) return false;
+  const DS_RadixType *type = &DS_RADIX_TYPES[CountTrailingZeros32((U32)size)];
+  U32 digits = (U32)size;
+  U32 task_count = (U32)Clamp(1, count / DS_RADIX_MIN_CHUNK, Clamp(1, threads, DS_RADIX_MAX_THREADS));
+  UZ counts_size = task_count > 1 ? task_count * sizeof(DS_RadixCounts) : 0;
+  if (count > (MAX_UZ - counts_size - sizeof(UZ)) / size) return false;
+  UZ buffer_size = MEM_FastAlignUp(count * size, sizeof(UZ));
+  U8 *buffer = MEM_Allocate(mem, buffer_size + counts_size);
+  if (!buffer) return false;
+
+  if (task_count == 1)
+  {
+    type->encode(items, count, kind, false);
+    DS_RadixSortRange(type, size, items, buffer, count, digits, items);
+    type->encode(items, count, kind, true);
+    MEM_Deallocate(mem, buffer);
+    return true;
+  }
+
+  DS_RadixTask tasks[DS_RADIX_MAX_THREADS];
+  OS_Thread handles[DS_RADIX_MAX_THREADS];
+  DS_RadixCounts *counts = (DS_RadixCounts*)(buffer + buffer_size);
+  UZ chunk = count / task_count;
+  for (U32 i = 0; i < task_count; ++i)
+  {
+    UZ end = i + 1 < task_count ? chunk * (i + 1) : count;
+    tasks[i] = (DS_RadixTask) { .type = type, .items = items, .buffer = buffer, .size = size, .begin = chunk * i, .end = end, .kind = kind, .counts = counts[i] };
+    MemoryZeroStruct(&counts[i]);
+  }
+  DS_RadixRun(tasks, handles, task_count, 0);
+
+  /* partition on the highest byte that differs between the values */
+  U32 digit = digits;
+  while (digit--)
+  {
+    bool same = false;
+    for (U32 value = 0; value < 256 && !same; ++value)
+    {
+      UZ total = 0;
+      for (U32 i = 0; i < task_count; ++i) total += counts[i][digit][value];
+      same = total == count;
+    }
+    if (!same) break;
+  }
+  if (digit == (U32)-1)
+  {
+    type->encode(items, count, kind, true);
+    MEM_Deallocate(mem, buffer);
+    return true;
+  }
+
+  /* each task scatters its values after the ones of the same byte from the tasks before it */
+  UZ starts[256], offset = 0;
+  for (U32 value = 0; value < 256; ++value)
+  {
+    starts[value] = offset;
+    for (U32 i = 0; i < task_count; ++i)
+    {
+      UZ values = counts[i][digit][value];
+      counts[i][digit][value] = offset;
+      offset += values;
+    }
+  }
+  for (U32 i = 0; i < task_count; ++i) tasks[i].digit = digit;
+  DS_RadixRun(tasks, handles, task_count, 1);
+
+  /* the tasks take whole partitions of about the same number of values */
+  UZ begin = 0;
+  U32 used = 0;
+  for (U32 value = 0; begin < count; ++value)
+  {
+    UZ end = value + 1 < 256 ? starts[value + 1] : count;
+    if (end < count && (used + 1 == task_count || end - begin < count / task_count)) continue;
+    tasks[used].begin = begin;
+    tasks[used].end = end;
+    tasks[used].starts = starts;
+    used++;
+    begin = end;
+  }
+  DS_RadixRun(tasks, handles, used, 2);
+  MEM_Deallocate(mem, buffer);
+  return true;
 }
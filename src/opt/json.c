@@ -251,39 +251,8 @@ bool JSON_ReadNumberValue(JSON *json, F64 *value)
   {
     UZ start = json->position;
     STR token = JSON_ReadNextToken(json);
-    if (token.size && (JSON_IsDigit(token.str[0]) || token.str[0] == '-'))
+    if (token.size && (JSON_IsDigit(token.str[0]) || token.str[0] == '-') && STR_ParseF64(token, value) == token.size)
     {
-      UZ i = 0;
-      F64 s = 1;
-      *value = 0;
-      if (token.str[i] == '-') s = -++i;
-      while (i < token.size && JSON_IsDigit(token.str[i]))
-      {
-        *value = *value * 10 + token.str[i++] - '0';
-      }
-      if (i < token.size && token.str[i] == '.')
-      {
-        F64 d = 10;
-        while (++i < token.size && JSON_IsDigit(token.str[i]))
-        {
-          *value = *value + (token.str[i] - '0') / d;
-        }
-      }
-      *value *= s;
-      if (i < token.size && (token.str[i] & 0xDF) == 'E')
-      {
-        F64 e = 0;
-        if (++i < token.size)
-        {
-          s = token.str[i] == '-' ? -1 : 1;
-          if (token.str[i] == '+' || token.str[i] == '-') ++i;
-        }
-        while (i < token.size && JSON_IsDigit(token.str[i]))
-        {
-          e = e * 10 + token.str[i++] - '0';
-        }
-        *value *= pow(10, e);
-      }
       return JSON_SwitchStateAfterValue(json);
     }
     json->position = start;
@@ -483,34 +452,21 @@ bool JSON_WriteStringValue(JSON *json, STR value)
 
 bool JSON_WriteInteger(JSON *json, U64 value)
 {
-  bool result = true;
-  UZ start = json->position;
-  do (result = JSON_WriteByte(json, value % 10 + '0')), value /= 10; while (result && value);
-  for (UZ i = 0; i < ((json->position - result) >> 1); ++i)
-  {
-    U8 byte = json->string.str[start + i];
-    json->string.str[start + i] = json->string.str[json->position - i - 1];
-  }
-  return result && JSON_SwitchStateAfterValue(json);
+  UZ size = STR_FormatU64(json->string.str + json->position, json->string.size - json->position, value);
+  json->position += size;
+  return size && JSON_SwitchStateAfterValue(json);
 }
 
 bool JSON_WriteNumberValue(JSON *json, F64 value, U32 precision)
 {
-  if (!JSON_WriteValueBegin(json)) return false;
-  if (value < 0)
-  {
-    if (!JSON_WriteByte(json, '-')) return false;
-    value = -value;
-  }
-  if (!JSON_WriteInteger(json, (U64)value)) return false;
-  if (precision)
-  {
-    if (!JSON_WriteByte(json, '.')) return false;
-    value -= (U64)value;
-    value *= pow(10, precision);
-    if (!JSON_WriteInteger(json, (U64)value)) return false;
-  }
-  return JSON_SwitchStateAfterValue(json);
+  if (!isfinite(value) || !JSON_WriteValueBegin(json)) return false;
+  U8 *buffer = json->string.str + json->position;
+  UZ capacity = json->string.size - json->position;
+  UZ size = precision == STR_PRECISION_SHORTEST
+    ? STR_FormatF64(buffer, capacity, value)
+    : STR_FormatF64Fixed(buffer, capacity, value, precision);
+  json->position += size;
+  return size && JSON_SwitchStateAfterValue(json);
 }
 
 bool JSON_WriteBooleanValue(JSON *json, bool value)
@@ -8,6 +8,7 @@ LEX LEX_Init(MEM *mem, STR source)
   {
     lex.mem = mem;
     lex.source = source;
+    lex.keyword_bytes = STR_ByteSetMake(STR_Static("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz"));
   }
   return lex;
 }
@@ -82,14 +83,11 @@ LEX_Token LEX_NextToken(LEX *lex)
 
 U16 LEX_DefaultKeyWordRule(LEX *lex, LEX_DefaultKeyWordCallback *callback)
 {
-  STR word = { lex->source.str + lex->position, 0 };
-  U8 byte = LEX_CurrentByte(lex);
-  while (byte == '_' || (U8)(byte - '0') < 10 || (U8)((byte & 0xDF) - 'A') < 26)
-  {
-    LEX_Increment(lex);
-    byte = LEX_CurrentByte(lex);
-    ++word.size;
-  }
+  UZ end = STR_FindFirstNotOf(lex->source, &lex->keyword_bytes, lex->position);
+  STR word = { lex->source.str + lex->position, end - lex->position };
+  /* a word never contains a newline, so only the column moves */
+  lex->position = end;
+  lex->column += (U16)word.size;
   return callback(word);
 }
 
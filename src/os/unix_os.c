@@ -9,6 +9,8 @@
 #include <sys/socket.h>
 #include <netdb.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <limits.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <unistd.h>
@@ -108,6 +110,33 @@ UZ OS_FileWrite(OS_File file, STR data)
   return (result == -1 ? 0 : (UZ)result);
 }
 
+UZ OS_FileWriteVector(OS_File file, const STR *data, UZ count)
+{
+  struct iovec vectors[64];
+  UZ result = 0;
+  while (count)
+  {
+    UZ batch = Min(count, ArrayLength(vectors));
+#ifdef IOV_MAX
+    batch = Min(batch, (UZ)IOV_MAX);
+#endif
+    UZ expected = 0;
+    for (UZ i = 0; i < batch; ++i)
+    {
+      vectors[i].iov_base = data[i].str;
+      vectors[i].iov_len = data[i].size;
+      expected += data[i].size;
+    }
+    SZ bytes = writev((int)(file - 1), vectors, (int)batch);
+    if (bytes == -1) break;
+    result += (UZ)bytes;
+    if ((UZ)bytes < expected) break;
+    data += batch;
+    count -= batch;
+  }
+  return result;
+}
+
 bool OS_FileExists(STR path)
 {
   return (access((char*)path.str, F_OK) == 0);
@@ -129,6 +129,18 @@ UZ OS_FileWrite(OS_File file, STR data)
   return result;
 }
 
+UZ OS_FileWriteVector(OS_File file, const STR *data, UZ count)
+{
+  UZ result = 0;
+  for (UZ i = 0; i < count; ++i)
+  {
+    UZ bytes = OS_FileWrite(file, data[i]);
+    result += bytes;
+    if (bytes < data[i].size) break;
+  }
+  return result;
+}
+
 bool OS_FileExists(STR path)
 {
   MEM_Arena arena = MEM_ArenaInit((path.size + 1) << 1);
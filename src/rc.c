@@ -79,3 +79,60 @@ void ARC_Free(PTR _arc)
     else OS_MutexUnlock(arc->mutex);
   }
 }
+
+/* the buffer is a generic RC followed by the bytes */
+#define RSTR_Buffer(rc) ((U8*)((Generic_RC)(rc) + 1))
+
+RSTR RSTR_From_STR(MEM *mem, STR string)
+{
+  RSTR result = { null };
+  if (!string.size) return result;
+  /* the bytes are all overwritten, so unlike __RC_Init only the header is initialized */
+  Generic_RC rc = MEM_Allocate(mem, sizeof(__Generic_RC) + string.size + 1);
+  if (!rc) return result;
+  rc->mem = mem;
+  rc->count = 1;
+  U8 *buffer = RSTR_Buffer(rc);
+  MemoryCopy(buffer, string.str, string.size);
+  buffer[string.size] = 0;
+  result.rc = rc;
+  result.string = (STR) { buffer, string.size };
+  return result;
+}
+
+RSTR RSTR_Clone(RSTR string)
+{
+  RC_Clone(string.rc);
+  return string;
+}
+
+void RSTR_Free(RSTR *string)
+{
+  RC_Free(string->rc);
+  MemoryZeroStruct(string);
+}
+
+RSTR RSTR_Slice(RSTR string, UZ begin, UZ end)
+{
+  RSTR result = { null };
+  end = Min(end, string.string.size);
+  if (begin >= end) return result;
+  result.rc = RC_Clone(string.rc);
+  result.string = (STR) { string.string.str + begin, end - begin };
+  return result;
+}
+
+bool RSTR_IsUnique(RSTR string)
+{
+  return !string.rc || ((Generic_RC)string.rc)->count == 1;
+}
+
+U8 *RSTR_Mutate(RSTR *string)
+{
+  if (RSTR_IsUnique(*string)) return string->string.str;
+  RSTR copy = RSTR_From_STR(((Generic_RC)string->rc)->mem, string->string);
+  if (!copy.rc) return null;
+  RC_Free(string->rc);
+  *string = copy;
+  return copy.string.str;
+}
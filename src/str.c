@@ -1,5 +1,51 @@
 #include <str.h>
 
+#if defined(ARCH_X64) || defined(ARCH_X86)
+#include <immintrin.h>
+#elif defined(SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(SIMD_ARM_CRC32)
+#include <arm_acle.h>
+#endif
+
+/* Returns the number of leading ASCII bytes, checking 32 bytes at a time. */
+static UZ STR_SkipASCII(const U8 *data, UZ size)
+{
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  for (; i + 32 <= size; i += 32)
+  {
+    U32 mask = (U32)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(data + i)));
+    if (mask) return i + CountTrailingZeros32(mask);
+  }
+#elif defined(SIMD_SSE2)
+  for (; i + 32 <= size; i += 32)
+  {
+    U32 low = (U32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i)));
+    U32 high = (U32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + i + 16)));
+    U32 mask = low | (high << 16);
+    if (mask) return i + CountTrailingZeros32(mask);
+  }
+#elif defined(SIMD_NEON)
+  for (; i + 32 <= size; i += 32)
+  {
+    uint8x16_t bytes = vorrq_u8(vld1q_u8(data + i), vld1q_u8(data + i + 16));
+    if (vmaxvq_u8(bytes) & 0x80) break;
+  }
+#endif
+  for (; i + 8 <= size; i += 8)
+  {
+    U64 word;
+    MemoryCopy(&word, data + i, 8);
+    word &= 0x8080808080808080ULL;
+    if (word) return i + (CountTrailingZeros64(word) >> 3);
+  }
+  while (i < size && data[i] < 0x80) ++i;
+  return i;
+}
+
 STR STR_Allocate(MEM *mem, UZ size)
 {
   STR string = { .str = MEM_Allocate(mem, size + 1) };
@@ -33,56 +79,432 @@ STR STR_Cat(MEM *mem, STR left, STR right)
   return string;
 }
 
+typedef struct STR_ReplaceMatch
+{
+  UZ position;
+  UZ rule;
+} STR_ReplaceMatch;
+
+/* Finds the next position where any rule matches, preferring the longest substring. */
+static UZ STR_ReplaceFindNext(const STR_ByteSet *first, const STR_ReplaceRule *rules, UZ count, STR string, UZ offset, UZ *rule)
+{
+  if (count == 1)
+  {
+    *rule = 0;
+    return STR_FindFirst(string, rules[0].substring, offset);
+  }
+  for (; (offset = STR_FindFirstOf(string, first, offset)) < string.size; ++offset)
+  {
+    U8 byte = string.str[offset];
+    UZ best = count;
+    for (UZ i = 0; i < count; ++i)
+    {
+      STR substring = rules[i].substring;
+      if (substring.size && substring.str[0] == byte && substring.size <= string.size - offset
+        && (best == count || substring.size > rules[best].substring.size)
+        && !memcmp(string.str + offset, substring.str, substring.size)) best = i;
+    }
+    if (best < count)
+    {
+      *rule = best;
+      return offset;
+    }
+  }
+  return string.size;
+}
+
+static void STR_ReplaceInitFirst(STR_ByteSet *first, const STR_ReplaceRule *rules, UZ count)
+{
+  MemoryZeroStruct(first);
+  for (UZ i = 0; i < count; ++i)
+  {
+    if (rules[i].substring.size) STR_ByteSetAdd(first, rules[i].substring.str[0]);
+  }
+}
+
 STR STR_Replace(MEM *mem, STR string, STR substring, STR replacement)
 {
-  UZ count = STR_Count(string, substring);
-  STR result = STR_Allocate(mem, string.size - substring.size * count + replacement.size * count);
-  for (UZ i = 0, j = 0; i < result.size && j < string.size;)
+  STR_ReplaceRule rule = { substring, replacement };
+  return STR_ReplaceMany(mem, string, &rule, 1);
+}
+
+STR STR_ReplaceMany(MEM *mem, STR string, const STR_ReplaceRule *rules, UZ count)
+{
+  STR_ReplaceMatch local[64], *matches = local;
+  UZ size = 0, capacity = ArrayLength(local), result = string.size;
+  STR_ByteSet first;
+  STR_ReplaceInitFirst(&first, rules, count);
+  if (count == 1 && !rules[0].substring.size) count = 0;
+  for (UZ offset = 0, rule; count && (offset = STR_ReplaceFindNext(&first, rules, count, string, offset, &rule)) < string.size;)
   {
-    UZ found = STR_FindFirst(string, substring, i);
-    if (found >= string.size)
+    if (size == capacity)
     {
-      MemoryCopy(result.str + j, string.str + i, string.size - i);
-      break;
+      STR_ReplaceMatch *grown = MEM_Reallocate(mem, matches == local ? nullptr : matches, sizeof(STR_ReplaceMatch) * (capacity << 1));
+      if (!grown)
+      {
+        if (matches != local) MEM_Deallocate(mem, matches);
+        return (STR) { null };
+      }
+      if (matches == local) MemoryCopy(grown, local, sizeof(local));
+      matches = grown;
+      capacity <<= 1;
     }
-    MemoryCopy(result.str + j, string.str + i, found - i);
-    j += found - i;
-    MemoryCopy(result.str + j, replacement.str, replacement.size);
-    j += replacement.size;
-    i = found + substring.size;
+    matches[size].position = offset;
+    matches[size++].rule = rule;
+    result += rules[rule].replacement.size - rules[rule].substring.size;
+    offset += rules[rule].substring.size;
   }
-  return result;
+
+  STR output = { null };
+  if (matches == local) output = STR_Allocate(mem, result);
+  else
+  {
+    /*
+     * Grow the match array into the result instead of allocating a second
+     * block, so arenas are never asked to free anything but their top. The
+     * matches are moved past the result and consumed ahead of the writes.
+     */
+    UZ tail = MEM_AlignUp(result + 1, sizeof(UZ));
+    U8 *block = MEM_Reallocate(mem, matches, tail + sizeof(STR_ReplaceMatch) * size);
+    if (!block)
+    {
+      MEM_Deallocate(mem, matches);
+      return output;
+    }
+    matches = MemoryCopy(block + tail, block, sizeof(STR_ReplaceMatch) * size);
+    output.str = block;
+    output.size = result;
+  }
+  if (output.str)
+  {
+    UZ from = 0, to = 0;
+    for (UZ i = 0; i < size; ++i)
+    {
+      STR_ReplaceRule rule = rules[matches[i].rule];
+      MemoryCopy(output.str + to, string.str + from, matches[i].position - from);
+      to += matches[i].position - from;
+      MemoryCopy(output.str + to, rule.replacement.str, rule.replacement.size);
+      to += rule.replacement.size;
+      from = matches[i].position + rule.substring.size;
+    }
+    MemoryCopy(output.str + to, string.str + from, string.size - from);
+    output.str[result] = 0;
+    if (matches != local)
+    {
+      U8 *str = MEM_Reallocate(mem, output.str, result + 1);
+      if (str) output.str = str;
+    }
+  }
+  return output;
 }
 
 UZ STR_Count(STR string, STR substring)
 {
   UZ count = 0;
-  for (UZ i = 0; i < string.size; ++i)
+  if (substring.size)
+  {
+    for (UZ i = STR_FindFirst(string, substring, 0); i < string.size; i = STR_FindFirst(string, substring, i + substring.size))
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+UZ STR_CountByte(STR string, U8 byte)
+{
+  UZ count = 0, i = 0;
+  /* matches are subtracted from byte counters, which are summed before they can overflow */
+#if defined(SIMD_AVX2)
+  for (__m256i target = _mm256_set1_epi8((char)byte); i + 32 <= string.size;)
+  {
+    __m256i counts = _mm256_setzero_si256();
+    for (UZ end = i + Min((string.size - i) / 32, (UZ)255) * 32; i < end; i += 32)
+    {
+      counts = _mm256_sub_epi8(counts, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(string.str + i)), target));
+    }
+    U64 sums[4];
+    _mm256_storeu_si256((__m256i*)sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    count += (UZ)(sums[0] + sums[1] + sums[2] + sums[3]);
+  }
+#elif defined(SIMD_SSE2)
+  for (__m128i target = _mm_set1_epi8((char)byte); i + 16 <= string.size;)
+  {
+    __m128i counts = _mm_setzero_si128();
+    for (UZ end = i + Min((string.size - i) / 16, (UZ)255) * 16; i < end; i += 16)
+    {
+      counts = _mm_sub_epi8(counts, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(string.str + i)), target));
+    }
+    counts = _mm_sad_epu8(counts, _mm_setzero_si128());
+    count += (UZ)_mm_cvtsi128_si32(counts) + (UZ)_mm_cvtsi128_si32(_mm_srli_si128(counts, 8));
+  }
+#elif defined(SIMD_NEON)
+  for (uint8x16_t target = vdupq_n_u8(byte); i + 16 <= string.size;)
+  {
+    uint8x16_t counts = vdupq_n_u8(0);
+    for (UZ end = i + Min((string.size - i) / 16, (UZ)255) * 16; i < end; i += 16)
+    {
+      counts = vsubq_u8(counts, vceqq_u8(vld1q_u8(string.str + i), target));
+    }
+    count += vaddlvq_u8(counts);
+  }
+#endif
+  for (U64 ones = 0x0101010101010101ULL, pattern = byte * ones; i + 8 <= string.size; i += 8)
+  {
+    U64 word;
+    MemoryCopy(&word, string.str + i, sizeof(word));
+    word ^= pattern;
+    /* sets the high bit of every zero byte, without borrows between bytes */
+    word = ~(((word & (0x7F * ones)) + 0x7F * ones) | word | (0x7F * ones));
+    count += PopCount64(word);
+  }
+  for (; i < string.size; ++i)
   {
-    i = STR_FindFirst(string, substring, i);
-    if (i < string.size) ++count;
+    count += string.str[i] == byte;
   }
   return count;
 }
 
 UZ STR_FindFirst(STR string, STR substring, UZ offset)
 {
-  if (string.size < substring.size) return string.size;
-  while (offset < string.size)
+  if (substring.size > string.size || offset > string.size - substring.size) return string.size;
+  if (!substring.size) return offset;
+  U8 first = substring.str[0];
+  UZ last = substring.size - 1, end = string.size - substring.size + 1;
+  /* compare the first and the last byte of every candidate before comparing the rest */
+#if defined(SIMD_AVX2)
+  for (__m256i f = _mm256_set1_epi8((char)first), l = _mm256_set1_epi8((char)substring.str[last]); offset + 32 <= end; offset += 32)
   {
-    if (offset < string.size - substring.size)
+    __m256i head = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(string.str + offset)), f);
+    __m256i tail = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(string.str + offset + last)), l);
+    for (U32 mask = (U32)_mm256_movemask_epi8(_mm256_and_si256(head, tail)); mask; mask &= mask - 1)
     {
-      STR slice = { .str = string.str + offset, .size = substring.size };
-      if (STR_Equals(slice, substring)) break;
+      UZ found = offset + CountTrailingZeros32(mask);
+      if (!memcmp(string.str + found + 1, substring.str + 1, last)) return found;
     }
-    else offset = string.size;
   }
-  return offset;
+#elif defined(SIMD_SSE2)
+  for (__m128i f = _mm_set1_epi8((char)first), l = _mm_set1_epi8((char)substring.str[last]); offset + 16 <= end; offset += 16)
+  {
+    __m128i head = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(string.str + offset)), f);
+    __m128i tail = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(string.str + offset + last)), l);
+    for (U32 mask = (U32)_mm_movemask_epi8(_mm_and_si128(head, tail)); mask; mask &= mask - 1)
+    {
+      UZ found = offset + CountTrailingZeros32(mask);
+      if (!memcmp(string.str + found + 1, substring.str + 1, last)) return found;
+    }
+  }
+#endif
+  while (offset < end)
+  {
+    U8 *found = memchr(string.str + offset, first, end - offset);
+    if (!found) break;
+    offset = (UZ)(found - string.str);
+    if (!memcmp(found + 1, substring.str + 1, last)) return offset;
+    ++offset;
+  }
+  return string.size;
 }
 
 UZ STR_FindLast(STR string, STR substring, UZ offset)
 {
-  return string.size; /* TODO: implement STR_FindLast */
+  if (!substring.size) return Min(offset, string.size);
+  if (substring.size > string.size) return string.size;
+  offset = Min(offset, string.size - substring.size);
+  for (UZ i = offset + 1; i--;)
+  {
+    if (string.str[i] == substring.str[0] && !memcmp(string.str + i, substring.str, substring.size)) return i;
+  }
+  return string.size;
+}
+
+STR_ByteSet STR_ByteSetMake(STR bytes)
+{
+  STR_ByteSet set = { 0 };
+  for (UZ i = 0; i < bytes.size; ++i)
+  {
+    STR_ByteSetAdd(&set, bytes.str[i]);
+  }
+  return set;
+}
+
+void STR_ByteSetAdd(STR_ByteSet *set, U8 byte)
+{
+  if (STR_ByteSetContains(set, byte)) return;
+  set->bits[byte >> 3] |= (U8)(1 << (byte & 7));
+  /* the low nibble selects a row, the high nibble a bit in it; bytes above 0x7F use the second table */
+  set->nibbles[byte >> 7][byte & 15] |= (U8)(1 << ((byte >> 4) & 7));
+  if (set->count < ArrayLength(set->bytes)) set->bytes[set->count] = byte;
+  ++set->count;
+}
+
+#if defined(SIMD_AVX2)
+static inline U32 STR_ByteSetMatch32(__m256i input, __m256i low, __m256i high)
+{
+  __m256i index = _mm256_and_si256(input, _mm256_set1_epi8((char)0x8F));
+  __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(low, index), _mm256_shuffle_epi8(high, _mm256_xor_si256(index, _mm256_set1_epi8((char)0x80))));
+  __m256i bits = _mm256_shuffle_epi8(_mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+    1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128), _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F)));
+  return (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), bits));
+}
+#elif defined(SIMD_SSSE3)
+static inline U32 STR_ByteSetMatch16(__m128i input, __m128i low, __m128i high)
+{
+  __m128i index = _mm_and_si128(input, _mm_set1_epi8((char)0x8F));
+  __m128i rows = _mm_or_si128(_mm_shuffle_epi8(low, index), _mm_shuffle_epi8(high, _mm_xor_si128(index, _mm_set1_epi8((char)0x80))));
+  __m128i bits = _mm_shuffle_epi8(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+    _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F)));
+  return (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, bits), bits));
+}
+#elif defined(SIMD_SSE2)
+static inline U32 STR_ByteSetMatch16(__m128i input, const STR_ByteSet *set)
+{
+  __m128i match = _mm_setzero_si128();
+  for (U32 i = 0; i < set->count; ++i)
+  {
+    match = _mm_or_si128(match, _mm_cmpeq_epi8(input, _mm_set1_epi8((char)set->bytes[i])));
+  }
+  return (U32)_mm_movemask_epi8(match);
+}
+#elif defined(SIMD_NEON)
+/* Returns 4 bits per matching byte. */
+static inline U64 STR_ByteSetMatch16(uint8x16_t input, uint8x16_t low, uint8x16_t high)
+{
+  static const U8 STR_NIBBLE_BITS[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t index = vandq_u8(input, vdupq_n_u8(0x8F));
+  uint8x16_t rows = vorrq_u8(vqtbl1q_u8(low, index), vqtbl1q_u8(high, veorq_u8(index, vdupq_n_u8(0x80))));
+  uint8x16_t match = vtstq_u8(rows, vqtbl1q_u8(vld1q_u8(STR_NIBBLE_BITS), vshrq_n_u8(input, 4)));
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+}
+#endif
+
+/* Finds the first byte in the set, or the first one outside of it when inverted has all bits set. */
+static UZ STR_ByteSetFind(STR string, const STR_ByteSet *set, UZ offset, U64 inverted)
+{
+  /* classify 64 (or 32) bytes at a time, looking both nibbles of every byte up in the set tables */
+#if defined(SIMD_AVX2)
+  __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[0]));
+  __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[1]));
+  for (; offset + 64 <= string.size; offset += 64)
+  {
+    U64 mask = STR_ByteSetMatch32(_mm256_loadu_si256((const __m256i*)(string.str + offset)), low, high);
+    mask |= (U64)STR_ByteSetMatch32(_mm256_loadu_si256((const __m256i*)(string.str + offset + 32)), low, high) << 32;
+    mask ^= inverted;
+    if (mask) return offset + CountTrailingZeros64(mask);
+  }
+  if (offset + 32 <= string.size)
+  {
+    U32 mask = STR_ByteSetMatch32(_mm256_loadu_si256((const __m256i*)(string.str + offset)), low, high) ^ (U32)inverted;
+    if (mask) return offset + CountTrailingZeros32(mask);
+    offset += 32;
+  }
+#elif defined(SIMD_SSSE3)
+  __m128i low = _mm_loadu_si128((const __m128i*)set->nibbles[0]);
+  __m128i high = _mm_loadu_si128((const __m128i*)set->nibbles[1]);
+  for (; offset + 32 <= string.size; offset += 32)
+  {
+    U32 mask = STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + offset)), low, high);
+    mask |= STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + offset + 16)), low, high) << 16;
+    mask ^= (U32)inverted;
+    if (mask) return offset + CountTrailingZeros32(mask);
+  }
+#elif defined(SIMD_SSE2)
+  /* without a byte shuffle, only small sets are worth comparing byte by byte */
+  if (set->count <= ArrayLength(set->bytes))
+  {
+    for (; offset + 32 <= string.size; offset += 32)
+    {
+      U32 mask = STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + offset)), set);
+      mask |= STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + offset + 16)), set) << 16;
+      mask ^= (U32)inverted;
+      if (mask) return offset + CountTrailingZeros32(mask);
+    }
+  }
+#elif defined(SIMD_NEON)
+  uint8x16_t low = vld1q_u8(set->nibbles[0]), high = vld1q_u8(set->nibbles[1]);
+  for (; offset + 32 <= string.size; offset += 32)
+  {
+    U64 mask = STR_ByteSetMatch16(vld1q_u8(string.str + offset), low, high) ^ inverted;
+    if (mask) return offset + (CountTrailingZeros64(mask) >> 2);
+    mask = STR_ByteSetMatch16(vld1q_u8(string.str + offset + 16), low, high) ^ inverted;
+    if (mask) return offset + 16 + (CountTrailingZeros64(mask) >> 2);
+  }
+#endif
+  for (; offset < string.size; ++offset)
+  {
+    if (STR_ByteSetContains(set, string.str[offset]) != (inverted & 1)) return offset;
+  }
+  return string.size;
+}
+
+UZ STR_FindFirstOf(STR string, const STR_ByteSet *set, UZ offset)
+{
+  if (offset >= string.size) return string.size;
+  if (set->count == 1)
+  {
+    U8 *found = memchr(string.str + offset, set->bytes[0], string.size - offset);
+    return found ? (UZ)(found - string.str) : string.size;
+  }
+  return STR_ByteSetFind(string, set, offset, 0);
+}
+
+UZ STR_FindFirstNotOf(STR string, const STR_ByteSet *set, UZ offset)
+{
+  if (offset >= string.size) return string.size;
+  return STR_ByteSetFind(string, set, offset, MAX_U64);
+}
+
+U64 STR_ByteSetClassify(const STR_ByteSet *set, STR string)
+{
+  UZ size = Min(string.size, (UZ)64), i = 0;
+  U64 mask = 0;
+#if defined(SIMD_AVX2)
+  __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[0]));
+  __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->nibbles[1]));
+  for (; i + 32 <= size; i += 32)
+  {
+    mask |= (U64)STR_ByteSetMatch32(_mm256_loadu_si256((const __m256i*)(string.str + i)), low, high) << i;
+  }
+#elif defined(SIMD_SSSE3)
+  __m128i low = _mm_loadu_si128((const __m128i*)set->nibbles[0]);
+  __m128i high = _mm_loadu_si128((const __m128i*)set->nibbles[1]);
+  for (; i + 16 <= size; i += 16)
+  {
+    mask |= (U64)STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + i)), low, high) << i;
+  }
+#elif defined(SIMD_SSE2)
+  for (; set->count <= ArrayLength(set->bytes) && i + 16 <= size; i += 16)
+  {
+    mask |= (U64)STR_ByteSetMatch16(_mm_loadu_si128((const __m128i*)(string.str + i)), set) << i;
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    mask |= (U64)STR_ByteSetContains(set, string.str[i]) << i;
+  }
+  return mask;
+}
+
+STR STR_SplitNext(STR_Split *split)
+{
+  STR string = split->string;
+  UZ start = split->position;
+  if (split->skip_empty)
+  {
+    while (start < string.size && STR_ByteSetContains(split->delimiters, string.str[start])) ++start;
+    if (start >= string.size)
+    {
+      split->position = string.size + 1;
+      return (STR) { 0 };
+    }
+  }
+  else if (start > string.size)
+  {
+    return (STR) { 0 };
+  }
+  UZ end = STR_FindFirstOf(string, split->delimiters, start);
+  split->position = end + 1;
+  return (STR) { .str = string.str + start, .size = end - start };
 }
 
 U32 STR_Hash(STR string)
@@ -118,6 +540,166 @@ bool STR_Equals(STR left, STR right)
   return result;
 }
 
+S32 STR_Compare(STR left, STR right)
+{
+  int result = memcmp(left.str, right.str, Min(left.size, right.size));
+  if (!result) return (left.size > right.size) - (left.size < right.size);
+  return result < 0 ? -1 : 1;
+}
+
+/* Returns 0x20 in every byte of the word that lies between first and first + 25. */
+static inline U64 STR_CaseMask64(U64 word, U8 first)
+{
+  U64 ones = 0x0101010101010101ULL, heptets = word & (0x7F * ones);
+  U64 from = heptets + (U64)(0x80 - first) * ones, above = heptets + (U64)(0x7F - (first + 25)) * ones;
+  return (~word & (from ^ above) & (0x80 * ones)) >> 2;
+}
+
+#define STR_FoldByte(c) ((U8)((c) | (((U8)((c) - 'A') < 26) << 5)))
+
+#if defined(SIMD_AVX2)
+/* Flips the case of the letters from first to first + 25, with shift = 0x80 - first. */
+static inline __m256i STR_ChangeCase32(__m256i bytes, __m256i shift)
+{
+  __m256i letters = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), _mm256_add_epi8(bytes, shift));
+  return _mm256_xor_si256(bytes, _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+}
+#elif defined(SIMD_SSE2)
+static inline __m128i STR_ChangeCase16(__m128i bytes, __m128i shift)
+{
+  __m128i letters = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), _mm_add_epi8(bytes, shift));
+  return _mm_xor_si128(bytes, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+}
+#elif defined(SIMD_NEON)
+static inline uint8x16_t STR_ChangeCase16(uint8x16_t bytes, uint8x16_t first)
+{
+  uint8x16_t letters = vcltq_u8(vsubq_u8(bytes, first), vdupq_n_u8(26));
+  return veorq_u8(bytes, vandq_u8(letters, vdupq_n_u8(0x20)));
+}
+#endif
+
+static void STR_ChangeCase(U8 *out, const U8 *in, UZ size, U8 first)
+{
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  for (__m256i shift = _mm256_set1_epi8((char)(0x80 - first)); i + 32 <= size; i += 32)
+  {
+    _mm256_storeu_si256((__m256i*)(out + i), STR_ChangeCase32(_mm256_loadu_si256((const __m256i*)(in + i)), shift));
+  }
+#elif defined(SIMD_SSE2)
+  for (__m128i shift = _mm_set1_epi8((char)(0x80 - first)); i + 16 <= size; i += 16)
+  {
+    _mm_storeu_si128((__m128i*)(out + i), STR_ChangeCase16(_mm_loadu_si128((const __m128i*)(in + i)), shift));
+  }
+#elif defined(SIMD_NEON)
+  for (uint8x16_t letter = vdupq_n_u8(first); i + 16 <= size; i += 16)
+  {
+    vst1q_u8(out + i, STR_ChangeCase16(vld1q_u8(in + i), letter));
+  }
+#endif
+  for (; i + 8 <= size; i += 8)
+  {
+    U64 word;
+    MemoryCopy(&word, in + i, sizeof(word));
+    word ^= STR_CaseMask64(word, first);
+    MemoryCopy(out + i, &word, sizeof(word));
+  }
+  for (; i < size; ++i)
+  {
+    out[i] = (U8)(in[i] ^ (((U8)(in[i] - first) < 26) << 5));
+  }
+}
+
+void STR_ToLowerInPlace(STR string)
+{
+  STR_ChangeCase(string.str, string.str, string.size, 'A');
+}
+
+void STR_ToUpperInPlace(STR string)
+{
+  STR_ChangeCase(string.str, string.str, string.size, 'a');
+}
+
+STR STR_ToLower(MEM *mem, STR string)
+{
+  STR result = STR_Allocate(mem, string.size);
+  if (result.str) STR_ChangeCase(result.str, string.str, string.size, 'A');
+  return result;
+}
+
+STR STR_ToUpper(MEM *mem, STR string)
+{
+  STR result = STR_Allocate(mem, string.size);
+  if (result.str) STR_ChangeCase(result.str, string.str, string.size, 'a');
+  return result;
+}
+
+bool STR_EqualsNoCase(STR left, STR right)
+{
+  if (left.size != right.size) return false;
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  for (__m256i shift = _mm256_set1_epi8((char)(0x80 - 'A')); i + 32 <= left.size; i += 32)
+  {
+    __m256i l = STR_ChangeCase32(_mm256_loadu_si256((const __m256i*)(left.str + i)), shift);
+    __m256i r = STR_ChangeCase32(_mm256_loadu_si256((const __m256i*)(right.str + i)), shift);
+    if ((U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r)) != MAX_U32) return false;
+  }
+#elif defined(SIMD_SSE2)
+  for (__m128i shift = _mm_set1_epi8((char)(0x80 - 'A')); i + 16 <= left.size; i += 16)
+  {
+    __m128i l = STR_ChangeCase16(_mm_loadu_si128((const __m128i*)(left.str + i)), shift);
+    __m128i r = STR_ChangeCase16(_mm_loadu_si128((const __m128i*)(right.str + i)), shift);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)) != 0xFFFF) return false;
+  }
+#elif defined(SIMD_NEON)
+  for (uint8x16_t letter = vdupq_n_u8('A'); i + 16 <= left.size; i += 16)
+  {
+    uint8x16_t l = STR_ChangeCase16(vld1q_u8(left.str + i), letter), r = STR_ChangeCase16(vld1q_u8(right.str + i), letter);
+    if (vminvq_u8(vceqq_u8(l, r)) != 0xFF) return false;
+  }
+#endif
+  for (; i + 8 <= left.size; i += 8)
+  {
+    U64 l, r;
+    MemoryCopy(&l, left.str + i, sizeof(l));
+    MemoryCopy(&r, right.str + i, sizeof(r));
+    if ((l ^ STR_CaseMask64(l, 'A')) != (r ^ STR_CaseMask64(r, 'A'))) return false;
+  }
+  for (; i < left.size; ++i)
+  {
+    if (STR_FoldByte(left.str[i]) != STR_FoldByte(right.str[i])) return false;
+  }
+  return true;
+}
+
+U32 STR_HashNoCase(STR string)
+{
+  return (U32)STR_Hash64NoCase(string);
+}
+
+U64 STR_Hash64NoCase(STR string)
+{
+  U64 hash = 0;
+  UZ i = 0;
+  /* the same hash as STR_Hash64 of the lower case string, taking eight bytes per step with the powers of 31 */
+  for (; i + 8 <= string.size; i += 8)
+  {
+    U64 word;
+    U8 b[8];
+    MemoryCopy(&word, string.str + i, sizeof(word));
+    word ^= STR_CaseMask64(word, 'A');
+    MemoryCopy(b, &word, sizeof(word));
+    hash = hash * 852891037441ULL + b[0] * 27512614111ULL + b[1] * 887503681ULL + b[2] * 28629151ULL
+      + b[3] * 923521ULL + b[4] * 29791ULL + b[5] * 961ULL + b[6] * 31ULL + b[7];
+  }
+  for (; i < string.size; ++i)
+  {
+    hash = (hash << 5) - hash + STR_FoldByte(string.str[i]);
+  }
+  return hash;
+}
+
 STR16 STR16_Make(U16 *s)
 {
   STR16 string = { .str = s };
@@ -138,57 +720,19 @@ STR16 STR16_Allocate(MEM *mem, UZ size)
 
 STR16 STR16_From_STR(MEM *mem, STR string)
 {
-  STR16 result = STR16_Allocate(mem, string.size);
-  UZ size = 0;
-  if (result.str)
-  {
-    for (UZ i = 0; i < string.size; ++i)
-    {
-      STR slice = { .str = string.str + i, .size = string.size - i };
-      S32 codepoint = UTF8_DecodeFirst(slice);
-      UZ count = UTF16_Encode(result.str + size, result.size - size, codepoint);
-      if (!count)
-      {
-        MEM_Deallocate(mem, result.str);
-        return (STR16) { 0 };
-      }
-      size += count;
-      if (codepoint > 0x7F) ++i;
-      if (codepoint > 0x7FF) ++i;
-      if (codepoint > 0xFFFF) ++i;
-    }
-    void *str = MEM_Reallocate(mem, result.str, (size + 1) << 1);
-    if (str) result.str = str;
-    result.str[size] = 0;
-    result.size = size;
-  }
+  UZ size = UTF8_GetUTF16Size(string);
+  if (!size && string.size) return (STR16) { 0 };
+  STR16 result = STR16_Allocate(mem, size);
+  if (result.str) UTF8_ToUTF16(result.str, result.size, string, nullptr);
   return result;
 }
 
 STR STR_From_STR16(MEM *mem, STR16 string)
 {
-  STR result = STR_Allocate(mem, string.size * 3);
-  UZ size = 0;
-  if (result.str)
-  {
-    for (UZ i = 0; i < string.size; ++i)
-    {
-      STR16 slice = { .str = string.str + i, .size = string.size - i };
-      S32 codepoint = UTF16_DecodeFirst(slice);
-      UZ count = UTF8_Encode(result.str + size, result.size - size, codepoint);
-      if (!count)
-      {
-        MEM_Deallocate(mem, result.str);
-        return (STR) { 0 };
-      }
-      size += count;
-      if (codepoint > 0xFFFF) ++i;
-    }
-    void *str = MEM_Reallocate(mem, result.str, size + 1);
-    if (str) result.str = str;
-    result.str[size] = 0;
-    result.size = size;
-  }
+  UZ size = UTF16_GetUTF8Size(string);
+  if (!size && string.size) return (STR) { 0 };
+  STR result = STR_Allocate(mem, size);
+  if (result.str) UTF16_ToUTF8(result.str, result.size, string, nullptr);
   return result;
 }
 
@@ -270,32 +814,375 @@ UZ UTF8_Encode(U8 *buffer, UZ capacity, S32 codepoint)
 
 UZ UTF8_GetLength(STR string)
 {
-  UZ length = 0;
-  for (UZ i = 0; i < string.size; ++i)
+  return UTF8_Validate(string) ? UTF8_CountCodepoints(string) : 0;
+}
+
+/* Decodes one well-formed sequence, returns its size or 0 if it is malformed or incomplete. */
+static UZ UTF8_DecodeStrict(const U8 *data, UZ size, U32 *codepoint)
+{
+  U8 byte = data[0], low = 0x80, high = 0xBF;
+  UZ count;
+  U32 result;
+  if (byte < 0x80)
   {
-    STR slice = { .str = string.str + i, .size = string.size - i };
-    S32 codepoint = UTF8_DecodeFirst(slice);
-    if (codepoint < 0) return 0;
-    if (codepoint > 0x7F) ++i;
-    if (codepoint > 0x7FF) ++i;
-    if (codepoint > 0xFFFF) ++i;
-    ++length;
+    *codepoint = byte;
+    return 1;
   }
-  return length;
+  if (byte >= 0xC2 && byte <= 0xDF)
+  {
+    count = 2;
+    result = byte & 0x1F;
+  }
+  else if (byte >= 0xE0 && byte <= 0xEF)
+  {
+    count = 3;
+    result = byte & 0x0F;
+    if (byte == 0xE0) low = 0xA0;
+    if (byte == 0xED) high = 0x9F;
+  }
+  else if (byte >= 0xF0 && byte <= 0xF4)
+  {
+    count = 4;
+    result = byte & 0x07;
+    if (byte == 0xF0) low = 0x90;
+    if (byte == 0xF4) high = 0x8F;
+  }
+  else return 0;
+  if (size < count || data[1] < low || data[1] > high) return 0;
+  result = (result << 6) | (data[1] & 0x3F);
+  for (UZ i = 2; i < count; ++i)
+  {
+    if ((data[i] & 0xC0) != 0x80) return 0;
+    result = (result << 6) | (data[i] & 0x3F);
+  }
+  *codepoint = result;
+  return count;
 }
 
-S32 UTF16_DecodeFirst(STR16 string)
+/* Validates sequences one by one starting from a character boundary. */
+static UZ UTF8_ValidateScalar(const U8 *data, UZ size, UZ i)
 {
-  U32 codepoint = -1;
-  U16 high = string.str[0];
-  switch (high & 0xFC00)
+  while (i < size)
   {
-  case 0xD800:
-    if (string.size > 1)
-    {
-      U16 low = string.str[1];
-      if ((low & 0xFC00) == 0xDC00)
-      {
+    U32 codepoint;
+    UZ count;
+    if (data[i] < 0x80) count = STR_SkipASCII(data + i, size - i);
+    else if (!(count = UTF8_DecodeStrict(data + i, size - i, &codepoint))) break;
+    i += count;
+  }
+  return i;
+}
+
+#if defined(SIMD_AVX2) || defined(SIMD_SSSE3)
+
+/* Moves back from a block boundary to the lead byte of a sequence crossing it. */
+static UZ UTF8_BoundaryBefore(const U8 *data, UZ position)
+{
+  for (UZ i = 1; i <= 3 && i <= position; ++i)
+  {
+    U8 byte = data[position - i];
+    if (byte < 0x80) break;
+    if (byte >= 0xC0) return position - i;
+  }
+  return position;
+}
+
+/*
+ * Block validation using the lookup algorithm by Keiser and Lemire: every
+ * error class of a two byte window is a bit, the bits of the high and low
+ * nibbles of the previous byte and the high nibble of the current byte are
+ * looked up and and-ed together, so any remaining bit is an error.
+ */
+#define UTF8_TOO_SHORT  (1 << 0)
+#define UTF8_TOO_LONG   (1 << 1)
+#define UTF8_OVERLONG_3 (1 << 2)
+#define UTF8_TOO_LARGE  (1 << 3)
+#define UTF8_SURROGATE  (1 << 4)
+#define UTF8_OVERLONG_2 (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4 (1 << 6)
+#define UTF8_TWO_CONTS  (1 << 7)
+#define UTF8_CARRY (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#define UTF8_BYTE_1_HIGH \
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+  UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, \
+  UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, \
+  UTF8_TOO_SHORT | UTF8_OVERLONG_2, \
+  UTF8_TOO_SHORT, \
+  UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE, \
+  UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+
+#define UTF8_BYTE_1_LOW \
+  UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4, \
+  UTF8_CARRY | UTF8_OVERLONG_2, \
+  UTF8_CARRY, \
+  UTF8_CARRY, \
+  UTF8_CARRY | UTF8_TOO_LARGE, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000, \
+  UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+
+#define UTF8_BYTE_2_HIGH \
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, \
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4, \
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE, \
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+  UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE, \
+  UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+
+#endif
+
+#if defined(SIMD_AVX2)
+
+#define UTF8_BLOCK_SIZE 32
+#define UTF8_Prev(input, prev, n) _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+static __m256i UTF8_CheckBlock(__m256i input, __m256i prev)
+{
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  __m256i prev1 = UTF8_Prev(input, prev, 1);
+  __m256i byte_1_high = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_1_HIGH, UTF8_BYTE_1_HIGH),
+    _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  __m256i byte_1_low = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_1_LOW, UTF8_BYTE_1_LOW),
+    _mm256_and_si256(prev1, nibble));
+  __m256i byte_2_high = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_2_HIGH, UTF8_BYTE_2_HIGH),
+    _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+  __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+  __m256i third = _mm256_subs_epu8(UTF8_Prev(input, prev, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(UTF8_Prev(input, prev, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+  __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+  return _mm256_xor_si256(must23, special);
+}
+
+static UZ UTF8_ValidateBlocks(const U8 *data, UZ size)
+{
+  const __m256i incomplete = _mm256_setr_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF, (char)0xDF, (char)0xBF);
+  __m256i prev = _mm256_setzero_si256();
+  __m256i pending = _mm256_setzero_si256();
+  UZ i = 0;
+  for (; i + UTF8_BLOCK_SIZE <= size; i += UTF8_BLOCK_SIZE)
+  {
+    __m256i input = _mm256_loadu_si256((const __m256i*)(data + i));
+    __m256i error;
+    if (_mm256_movemask_epi8(input))
+    {
+      /* the check of a non-ASCII block covers sequences from the previous one */
+      error = UTF8_CheckBlock(input, prev);
+      pending = _mm256_subs_epu8(input, incomplete);
+    }
+    else
+    {
+      error = pending;
+      pending = _mm256_setzero_si256();
+    }
+    if (!_mm256_testz_si256(error, error)) break;
+    prev = input;
+  }
+  return i;
+}
+
+#elif defined(SIMD_SSSE3)
+
+#define UTF8_BLOCK_SIZE 16
+#define UTF8_Prev(input, prev, n) _mm_alignr_epi8((input), (prev), 16 - (n))
+
+static __m128i UTF8_CheckBlock(__m128i input, __m128i prev)
+{
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  __m128i prev1 = UTF8_Prev(input, prev, 1);
+  __m128i byte_1_high = _mm_shuffle_epi8(_mm_setr_epi8(UTF8_BYTE_1_HIGH),
+    _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte_1_low = _mm_shuffle_epi8(_mm_setr_epi8(UTF8_BYTE_1_LOW),
+    _mm_and_si128(prev1, nibble));
+  __m128i byte_2_high = _mm_shuffle_epi8(_mm_setr_epi8(UTF8_BYTE_2_HIGH),
+    _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+  __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+  __m128i third = _mm_subs_epu8(UTF8_Prev(input, prev, 2), _mm_set1_epi8((char)(0xE0 - 0x80)));
+  __m128i fourth = _mm_subs_epu8(UTF8_Prev(input, prev, 3), _mm_set1_epi8((char)(0xF0 - 0x80)));
+  __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+  return _mm_xor_si128(must23, special);
+}
+
+static UZ UTF8_ValidateBlocks(const U8 *data, UZ size)
+{
+  const __m128i incomplete = _mm_setr_epi8(
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF, (char)0xDF, (char)0xBF);
+  __m128i prev = _mm_setzero_si128();
+  __m128i pending = _mm_setzero_si128();
+  UZ i = 0;
+  for (; i + UTF8_BLOCK_SIZE <= size; i += UTF8_BLOCK_SIZE)
+  {
+    __m128i input = _mm_loadu_si128((const __m128i*)(data + i));
+    __m128i error;
+    if (_mm_movemask_epi8(input))
+    {
+      /* the check of a non-ASCII block covers sequences from the previous one */
+      error = UTF8_CheckBlock(input, prev);
+      pending = _mm_subs_epu8(input, incomplete);
+    }
+    else
+    {
+      error = pending;
+      pending = _mm_setzero_si128();
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF) break;
+    prev = input;
+  }
+  return i;
+}
+
+#endif
+
+UZ UTF8_GetValidSize(STR string)
+{
+  UZ i = 0;
+  if (!string.str) return 0;
+#if defined(SIMD_AVX2) || defined(SIMD_SSSE3)
+  /* blocks before the first failing one are valid up to sequences crossing its start */
+  i = UTF8_BoundaryBefore(string.str, UTF8_ValidateBlocks(string.str, string.size));
+#endif
+  return UTF8_ValidateScalar(string.str, string.size, i);
+}
+
+bool UTF8_Validate(STR string)
+{
+  return UTF8_GetValidSize(string) == string.size;
+}
+
+UZ UTF8_CountCodepoints(STR string)
+{
+  UZ count = 0, i = 0;
+  if (!string.str) return 0;
+#if defined(SIMD_AVX2)
+  for (const __m256i limit = _mm256_set1_epi8(-65); i + 32 <= string.size; i += 32)
+  {
+    __m256i bytes = _mm256_loadu_si256((const __m256i*)(string.str + i));
+    count += PopCount32((U32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(bytes, limit)));
+  }
+#elif defined(SIMD_SSE2)
+  for (const __m128i limit = _mm_set1_epi8(-65); i + 32 <= string.size; i += 32)
+  {
+    __m128i low = _mm_loadu_si128((const __m128i*)(string.str + i));
+    __m128i high = _mm_loadu_si128((const __m128i*)(string.str + i + 16));
+    U32 mask = (U32)_mm_movemask_epi8(_mm_cmpgt_epi8(low, limit))
+      | ((U32)_mm_movemask_epi8(_mm_cmpgt_epi8(high, limit)) << 16);
+    count += PopCount32(mask);
+  }
+#elif defined(SIMD_NEON)
+  for (const int8x16_t limit = vdupq_n_s8(-65); i + 32 <= string.size; i += 32)
+  {
+    uint8x16_t low = vcgtq_s8(vld1q_s8((const S8*)string.str + i), limit);
+    uint8x16_t high = vcgtq_s8(vld1q_s8((const S8*)string.str + i + 16), limit);
+    count += vaddvq_u8(vshrq_n_u8(low, 7)) + vaddvq_u8(vshrq_n_u8(high, 7));
+  }
+#endif
+  for (; i + 8 <= string.size; i += 8)
+  {
+    U64 word;
+    MemoryCopy(&word, string.str + i, 8);
+    count += 8 - PopCount64(word & (~word << 1) & 0x8080808080808080ULL);
+  }
+  for (; i < string.size; ++i) count += (string.str[i] & 0xC0) != 0x80;
+  return count;
+}
+
+UZ UTF8_GetUTF16Size(STR string)
+{
+  UZ size = 0, i = 0;
+  if (!UTF8_Validate(string)) return 0;
+  for (; i + 8 <= string.size; i += 8)
+  {
+    U64 word;
+    MemoryCopy(&word, string.str + i, 8);
+    size += 8 - PopCount64(word & (~word << 1) & 0x8080808080808080ULL);
+    size += PopCount64(word & (word << 1) & (word << 2) & (word << 3) & 0x8080808080808080ULL);
+  }
+  for (; i < string.size; ++i)
+  {
+    size += ((string.str[i] & 0xC0) != 0x80) + (string.str[i] >= 0xF0);
+  }
+  return size;
+}
+
+UZ UTF8_ToUTF16(U16 *buffer, UZ capacity, STR string, UZ *consumed)
+{
+  UZ i = 0, size = 0;
+  while (i < string.size)
+  {
+#if defined(SIMD_AVX2)
+    while (i + 16 <= string.size && size + 16 <= capacity)
+    {
+      __m128i bytes = _mm_loadu_si128((const __m128i*)(string.str + i));
+      if (_mm_movemask_epi8(bytes)) break;
+      _mm256_storeu_si256((__m256i*)(buffer + size), _mm256_cvtepu8_epi16(bytes));
+      i += 16;
+      size += 16;
+    }
+#elif defined(SIMD_SSE2)
+    while (i + 16 <= string.size && size + 16 <= capacity)
+    {
+      __m128i bytes = _mm_loadu_si128((const __m128i*)(string.str + i));
+      if (_mm_movemask_epi8(bytes)) break;
+      _mm_storeu_si128((__m128i*)(buffer + size), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+      _mm_storeu_si128((__m128i*)(buffer + size + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+      i += 16;
+      size += 16;
+    }
+#elif defined(SIMD_NEON)
+    while (i + 16 <= string.size && size + 16 <= capacity)
+    {
+      uint8x16_t bytes = vld1q_u8(string.str + i);
+      if (vmaxvq_u8(bytes) & 0x80) break;
+      vst1q_u16(buffer + size, vmovl_u8(vget_low_u8(bytes)));
+      vst1q_u16(buffer + size + 8, vmovl_u8(vget_high_u8(bytes)));
+      i += 16;
+      size += 16;
+    }
+#endif
+    U32 codepoint;
+    UZ count = i < string.size ? UTF8_DecodeStrict(string.str + i, string.size - i, &codepoint) : 0;
+    if (!count) break;
+    if (codepoint < 0x10000)
+    {
+      if (size >= capacity) break;
+      buffer[size++] = (U16)codepoint;
+    }
+    else
+    {
+      if (capacity - size < 2) break;
+      buffer[size++] = (U16)(0xD800 | ((codepoint - 0x10000) >> 10));
+      buffer[size++] = (U16)(0xDC00 | (codepoint & 0x3FF));
+    }
+    i += count;
+  }
+  if (consumed) *consumed = i;
+  return size;
+}
+
+S32 UTF16_DecodeFirst(STR16 string)
+{
+  U32 codepoint = -1;
+  U16 high = string.str[0];
+  switch (high & 0xFC00)
+  {
+  case 0xD800:
+    if (string.size > 1)
+    {
+      U16 low = string.str[1];
+      if ((low & 0xFC00) == 0xDC00)
+      {
         U32 offset = (low & 0x3FF) | ((high & 0x3FF) << 10);
         codepoint = 0x10000 + offset;
       }
@@ -350,6 +1237,134 @@ UZ UTF16_GetLength(STR16 string)
   return length;
 }
 
+/* Decodes one well-formed codepoint, returns the units used or 0 for lone surrogates. */
+static UZ UTF16_DecodeStrict(const U16 *data, UZ size, U32 *codepoint)
+{
+  U16 high = data[0];
+  if ((high & 0xF800) != 0xD800)
+  {
+    *codepoint = high;
+    return 1;
+  }
+  if (high >= 0xDC00 || size < 2 || (data[1] & 0xFC00) != 0xDC00) return 0;
+  *codepoint = 0x10000 + (((U32)(high & 0x3FF) << 10) | (data[1] & 0x3FF));
+  return 2;
+}
+
+/* Returns the number of leading units below 0x80, checking 16 units at a time. */
+static UZ UTF16_SkipASCII(const U16 *data, UZ size)
+{
+  UZ i = 0;
+#if defined(SIMD_SSE2)
+  for (const __m128i mask = _mm_set1_epi16((short)0xFF80); i + 16 <= size; i += 16)
+  {
+    __m128i low = _mm_and_si128(_mm_loadu_si128((const __m128i*)(data + i)), mask);
+    __m128i high = _mm_and_si128(_mm_loadu_si128((const __m128i*)(data + i + 8)), mask);
+    __m128i zero = _mm_cmpeq_epi16(_mm_or_si128(low, high), _mm_setzero_si128());
+    if (_mm_movemask_epi8(zero) != 0xFFFF) break;
+  }
+#elif defined(SIMD_NEON)
+  for (const uint16x8_t mask = vdupq_n_u16(0xFF80); i + 16 <= size; i += 16)
+  {
+    uint16x8_t units = vorrq_u16(vld1q_u16(data + i), vld1q_u16(data + i + 8));
+    if (vmaxvq_u16(vandq_u16(units, mask))) break;
+  }
+#endif
+  while (i < size && data[i] < 0x80) ++i;
+  return i;
+}
+
+UZ UTF16_GetUTF8Size(STR16 string)
+{
+  UZ size = 0;
+  for (UZ i = 0; i < string.size;)
+  {
+    UZ ascii = UTF16_SkipASCII(string.str + i, string.size - i);
+    size += ascii;
+    i += ascii;
+    if (i < string.size)
+    {
+      U16 unit = string.str[i];
+      if (unit < 0x800)
+      {
+        size += 2;
+        ++i;
+      }
+      else if ((unit & 0xF800) != 0xD800)
+      {
+        size += 3;
+        ++i;
+      }
+      else
+      {
+        U32 codepoint;
+        if (!UTF16_DecodeStrict(string.str + i, string.size - i, &codepoint)) return 0;
+        size += 4;
+        i += 2;
+      }
+    }
+  }
+  return size;
+}
+
+UZ UTF16_ToUTF8(U8 *buffer, UZ capacity, STR16 string, UZ *consumed)
+{
+  UZ i = 0, size = 0;
+  while (i < string.size)
+  {
+#if defined(SIMD_SSE2)
+    for (const __m128i mask = _mm_set1_epi16((short)0xFF80); i + 16 <= string.size && size + 16 <= capacity; i += 16, size += 16)
+    {
+      __m128i low = _mm_loadu_si128((const __m128i*)(string.str + i));
+      __m128i high = _mm_loadu_si128((const __m128i*)(string.str + i + 8));
+      __m128i zero = _mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(low, high), mask), _mm_setzero_si128());
+      if (_mm_movemask_epi8(zero) != 0xFFFF) break;
+      _mm_storeu_si128((__m128i*)(buffer + size), _mm_packus_epi16(low, high));
+    }
+#elif defined(SIMD_NEON)
+    for (const uint16x8_t mask = vdupq_n_u16(0xFF80); i + 16 <= string.size && size + 16 <= capacity; i += 16, size += 16)
+    {
+      uint16x8_t low = vld1q_u16(string.str + i);
+      uint16x8_t high = vld1q_u16(string.str + i + 8);
+      if (vmaxvq_u16(vandq_u16(vorrq_u16(low, high), mask))) break;
+      vst1q_u8(buffer + size, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+#endif
+    U32 codepoint;
+    UZ count = i < string.size ? UTF16_DecodeStrict(string.str + i, string.size - i, &codepoint) : 0;
+    if (!count) break;
+    if (codepoint < 0x80)
+    {
+      if (size >= capacity) break;
+      buffer[size++] = (U8)codepoint;
+    }
+    else if (codepoint < 0x800)
+    {
+      if (capacity - size < 2) break;
+      buffer[size++] = (U8)(0xC0 | (codepoint >> 6));
+      buffer[size++] = (U8)(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+      if (capacity - size < 3) break;
+      buffer[size++] = (U8)(0xE0 | (codepoint >> 12));
+      buffer[size++] = (U8)(0x80 | ((codepoint >> 6) & 0x3F));
+      buffer[size++] = (U8)(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+      if (capacity - size < 4) break;
+      buffer[size++] = (U8)(0xF0 | (codepoint >> 18));
+      buffer[size++] = (U8)(0x80 | ((codepoint >> 12) & 0x3F));
+      buffer[size++] = (U8)(0x80 | ((codepoint >> 6) & 0x3F));
+      buffer[size++] = (U8)(0x80 | (codepoint & 0x3F));
+    }
+    i += count;
+  }
+  if (consumed) *consumed = i;
+  return size;
+}
+
 USTR USTR_Init(STR string)
 {
   USTR result = { 0 };
@@ -481,3 +1496,3039 @@ bool USTR_Equals(USTR left, USTR right)
   }
   return result;
 }
+
+S32 USTR_Compare(USTR left, USTR right)
+{
+  /* the unused prefix bytes are zero, so a tie on the prefix is only ambiguous for sizes above 4 */
+  U32 l = ByteSwap32(left.prefix.u), r = ByteSwap32(right.prefix.u);
+  if (l != r) return l < r ? -1 : 1;
+  if (left.size > 4 && right.size > 4)
+  {
+    const U8 *ld = left.size < 12 ? left.data.s : left.data.p;
+    const U8 *rd = right.size < 12 ? right.data.s : right.data.p;
+    int result = memcmp(ld, rd, Min(left.size, right.size) - 4);
+    if (result) return result < 0 ? -1 : 1;
+  }
+  return (left.size > right.size) - (left.size < right.size);
+}
+
+/*
+ * Multikey quicksort that partitions on 8 bytes of the key at a time instead
+ * of one. Every level compares the big-endian chunk at the current depth and
+ * the number of bytes it holds, so only the keys tied on a full chunk are
+ * inspected any further. USTR starts with its inline prefix, which keeps the
+ * first level (and most of the sort for short or distinct keys) within the
+ * array itself.
+ */
+typedef struct STR_SortKey
+{
+  U64 chunk;
+  UZ size;
+} STR_SortKey;
+
+static inline STR_SortKey STR_SortKeyAt(const U8 *data, UZ size)
+{
+  STR_SortKey key = { 0, Min(size, 8) };
+  if (key.size == 8) MemoryCopy(&key.chunk, data, 8);
+  else if (key.size) MemoryCopy(&key.chunk, data, key.size);
+  key.chunk = ByteSwap64(key.chunk);
+  return key;
+}
+
+static inline STR_SortKey STR_SortKey_STR(const STR *string, UZ depth)
+{
+  return STR_SortKeyAt(string->str + depth, string->size > depth ? string->size - depth : 0);
+}
+
+static inline STR_SortKey USTR_SortKey_USTR(const USTR *string, UZ depth)
+{
+  if (!depth) return (STR_SortKey) { (U64)ByteSwap32(string->prefix.u) << 32, Min(string->size, 4) };
+  return STR_SortKeyAt((string->size < 12 ? string->data.s : string->data.p) + depth - 4, string->size > depth ? string->size - depth : 0);
+}
+
+#define STR_SortKeyLess(a, b) ((a).chunk != (b).chunk ? (a).chunk < (b).chunk : (a).size < (b).size)
+#define STR_SortKeyEqual(a, b) ((a).chunk == (b).chunk && (a).size == (b).size)
+
+#define STR_SORT_INSERTION  16
+
+#define STR_SortDefine(T, KEY, WIDTH)                                               \
+static void Glue(T, _SortRange)(T *items, UZ count, UZ depth)                       \
+{                                                                                   \
+  while (count > STR_SORT_INSERTION)                                                \
+  {                                                                                 \
+    STR_SortKey a = KEY(&items[0], depth);                                          \
+    STR_SortKey b = KEY(&items[count >> 1], depth);                                 \
+    STR_SortKey c = KEY(&items[count - 1], depth);                                  \
+    STR_SortKey pivot = STR_SortKeyLess(a, b)                                       \
+      ? (STR_SortKeyLess(b, c) ? b : (STR_SortKeyLess(a, c) ? c : a))               \
+      : (STR_SortKeyLess(a, c) ? a : (STR_SortKeyLess(b, c) ? c : b));              \
+    UZ lt = 0, i = 0, gt = count;                                                   \
+    while (i < gt)                                                                  \
+    {                                                                               \
+      STR_SortKey key = KEY(&items[i], depth);                                      \
+      T item = items[i];                                                            \
+      if (STR_SortKeyLess(key, pivot)) { items[i++] = items[lt]; items[lt++] = item; } \
+      else if (STR_SortKeyEqual(key, pivot)) ++i;                                   \
+      else { items[i] = items[--gt]; items[gt] = item; }                            \
+    }                                                                               \
+    /* only the largest part is iterated on, so the recursion is O(log n) deep */   \
+    UZ less = lt, greater = count - gt;                                             \
+    UZ equal = pivot.size < WIDTH(depth) ? 0 : gt - lt;                             \
+    if (equal >= less && equal >= greater)                                          \
+    {                                                                               \
+      Glue(T, _SortRange)(items, less, depth);                                      \
+      Glue(T, _SortRange)(items + gt, greater, depth);                              \
+      items += lt;                                                                  \
+      count = equal;                                                                \
+      depth += WIDTH(depth);                                                        \
+      continue;                                                                     \
+    }                                                                               \
+    Glue(T, _SortRange)(items + lt, equal, depth + WIDTH(depth));                   \
+    if (less >= greater)                                                            \
+    {                                                                               \
+      Glue(T, _SortRange)(items + gt, greater, depth);                              \
+      count = less;                                                                 \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+      Glue(T, _SortRange)(items, less, depth);                                      \
+      items += gt;                                                                  \
+      count = greater;                                                              \
+    }                                                                               \
+  }                                                                                 \
+  for (UZ i = 1; i < count; ++i)                                                    \
+  {                                                                                 \
+    T item = items[i];                                                              \
+    UZ j = i;                                                                       \
+    for (; j && Glue(T, _Compare)(item, items[j - 1]) < 0; --j) items[j] = items[j - 1]; \
+    items[j] = item;                                                                \
+  }                                                                                 \
+}                                                                                   \
+                                                                                    \
+void Glue(T, _Sort)(T *items, UZ count)                                             \
+{                                                                                   \
+  Glue(T, _SortRange)(items, count, 0);                                             \
+}
+
+#define STR_SortWidth(depth) 8
+#define USTR_SortWidth(depth) ((depth) ? 8 : 4)
+
+STR_SortDefine(STR, STR_SortKey_STR, STR_SortWidth)
+STR_SortDefine(USTR, USTR_SortKey_USTR, USTR_SortWidth)
+
+/*
+ * Floats are parsed with the Eisel-Lemire algorithm, which rounds correctly
+ * from up to 19 significant digits with one or two 64x64 bit products, and
+ * formatted with Ryu, which finds the shortest digits that parse back to the
+ * same value. Both read the 128 most significant bits of 5^q: the positive
+ * powers are truncated, the negative powers are reciprocals rounded up down to
+ * q = -27 and truncated below. The Ryu multipliers are the same values with
+ * their top 125 bits.
+ */
+static const U64 STR_POW5_128[668][2] =
+{
+  { 0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL },
+  { 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL },
+  { 0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL },
+  { 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL },
+  { 0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL },
+  { 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL },
+  { 0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL },
+  { 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL },
+  { 0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL },
+  { 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL },
+  { 0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL },
+  { 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL },
+  { 0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL },
+  { 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL },
+  { 0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL },
+  { 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL },
+  { 0x84A57695FE98746DULL, 0x014BB630F7604B57ULL },
+  { 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL },
+  { 0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL },
+  { 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL },
+  { 0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL },
+  { 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL },
+  { 0xFD00B897478238D0ULL, 0x8920B098955522B4ULL },
+  { 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL },
+  { 0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL },
+  { 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL },
+  { 0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL },
+  { 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL },
+  { 0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL },
+  { 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL },
+  { 0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL },
+  { 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL },
+  { 0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL },
+  { 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL },
+  { 0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL },
+  { 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL },
+  { 0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL },
+  { 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL },
+  { 0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL },
+  { 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL },
+  { 0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL },
+  { 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL },
+  { 0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL },
+  { 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL },
+  { 0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL },
+  { 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL },
+  { 0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL },
+  { 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL },
+  { 0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL },
+  { 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL },
+  { 0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL },
+  { 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL },
+  { 0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL },
+  { 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL },
+  { 0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL },
+  { 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL },
+  { 0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL },
+  { 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL },
+  { 0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL },
+  { 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL },
+  { 0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL },
+  { 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL },
+  { 0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL },
+  { 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL },
+  { 0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL },
+  { 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL },
+  { 0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL },
+  { 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL },
+  { 0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL },
+  { 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL },
+  { 0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL },
+  { 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL },
+  { 0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL },
+  { 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL },
+  { 0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL },
+  { 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL },
+  { 0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL },
+  { 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL },
+  { 0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL },
+  { 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL },
+  { 0xC987434744AC874EULL, 0xA327FFB266B56220ULL },
+  { 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL },
+  { 0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL },
+  { 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL },
+  { 0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL },
+  { 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL },
+  { 0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL },
+  { 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL },
+  { 0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL },
+  { 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL },
+  { 0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL },
+  { 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL },
+  { 0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL },
+  { 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL },
+  { 0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL },
+  { 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL },
+  { 0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL },
+  { 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL },
+  { 0xAECC49914078536DULL, 0x58FAE9F773886E18ULL },
+  { 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL },
+  { 0x888F99797A5E012DULL, 0x6D8406C952429603ULL },
+  { 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL },
+  { 0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL },
+  { 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL },
+  { 0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL },
+  { 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL },
+  { 0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL },
+  { 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL },
+  { 0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL },
+  { 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL },
+  { 0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL },
+  { 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL },
+  { 0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL },
+  { 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL },
+  { 0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL },
+  { 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL },
+  { 0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL },
+  { 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL },
+  { 0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL },
+  { 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL },
+  { 0xB913179899F68584ULL, 0x28E2557B59846E3FULL },
+  { 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL },
+  { 0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL },
+  { 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL },
+  { 0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL },
+  { 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL },
+  { 0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL },
+  { 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL },
+  { 0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL },
+  { 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL },
+  { 0xD77485CB25823AC7ULL, 0x7D633293366B828BULL },
+  { 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL },
+  { 0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL },
+  { 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL },
+  { 0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL },
+  { 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL },
+  { 0xCD795BE870516656ULL, 0x67902E276C921F8BULL },
+  { 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL },
+  { 0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL },
+  { 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL },
+  { 0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL },
+  { 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL },
+  { 0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL },
+  { 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL },
+  { 0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL },
+  { 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL },
+  { 0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL },
+  { 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL },
+  { 0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL },
+  { 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL },
+  { 0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL },
+  { 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL },
+  { 0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL },
+  { 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL },
+  { 0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL },
+  { 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL },
+  { 0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL },
+  { 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL },
+  { 0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL },
+  { 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL },
+  { 0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL },
+  { 0xD47487CC8470652BULL, 0x7647C3200069671FULL },
+  { 0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL },
+  { 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL },
+  { 0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL },
+  { 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL },
+  { 0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL },
+  { 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL },
+  { 0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL },
+  { 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL },
+  { 0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL },
+  { 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL },
+  { 0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL },
+  { 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL },
+  { 0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL },
+  { 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL },
+  { 0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL },
+  { 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL },
+  { 0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL },
+  { 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL },
+  { 0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL },
+  { 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL },
+  { 0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL },
+  { 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL },
+  { 0x8C974F7383725573ULL, 0x1E414218C73A13FBULL },
+  { 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL },
+  { 0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL },
+  { 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL },
+  { 0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL },
+  { 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL },
+  { 0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL },
+  { 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL },
+  { 0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL },
+  { 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL },
+  { 0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL },
+  { 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL },
+  { 0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL },
+  { 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL },
+  { 0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL },
+  { 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL },
+  { 0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL },
+  { 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL },
+  { 0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL },
+  { 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL },
+  { 0xBE89523386091465ULL, 0xF6BBB397F1135823ULL },
+  { 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL },
+  { 0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL },
+  { 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL },
+  { 0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL },
+  { 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL },
+  { 0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL },
+  { 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL },
+  { 0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL },
+  { 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL },
+  { 0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL },
+  { 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL },
+  { 0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL },
+  { 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL },
+  { 0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL },
+  { 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL },
+  { 0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL },
+  { 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL },
+  { 0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL },
+  { 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL },
+  { 0x811CCC668829B887ULL, 0x0806357D5A3F525FULL },
+  { 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL },
+  { 0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL },
+  { 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL },
+  { 0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL },
+  { 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL },
+  { 0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL },
+  { 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL },
+  { 0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL },
+  { 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL },
+  { 0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL },
+  { 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL },
+  { 0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL },
+  { 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL },
+  { 0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL },
+  { 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL },
+  { 0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL },
+  { 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL },
+  { 0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL },
+  { 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL },
+  { 0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL },
+  { 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL },
+  { 0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL },
+  { 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL },
+  { 0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL },
+  { 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL },
+  { 0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL },
+  { 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL },
+  { 0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL },
+  { 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL },
+  { 0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL },
+  { 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL },
+  { 0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL },
+  { 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL },
+  { 0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL },
+  { 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL },
+  { 0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL },
+  { 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL },
+  { 0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL },
+  { 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL },
+  { 0xED246723473E3813ULL, 0x290123E9AAB23B68ULL },
+  { 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL },
+  { 0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL },
+  { 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL },
+  { 0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL },
+  { 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL },
+  { 0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL },
+  { 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL },
+  { 0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL },
+  { 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL },
+  { 0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL },
+  { 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL },
+  { 0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL },
+  { 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL },
+  { 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL },
+  { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL },
+  { 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL },
+  { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL },
+  { 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL },
+  { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL },
+  { 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL },
+  { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL },
+  { 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL },
+  { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL },
+  { 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL },
+  { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL },
+  { 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL },
+  { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL },
+  { 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL },
+  { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL },
+  { 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL },
+  { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL },
+  { 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL },
+  { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL },
+  { 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL },
+  { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL },
+  { 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL },
+  { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL },
+  { 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL },
+  { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL },
+  { 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL },
+  { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL },
+  { 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL },
+  { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL },
+  { 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL },
+  { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL },
+  { 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL },
+  { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL },
+  { 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL },
+  { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL },
+  { 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL },
+  { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL },
+  { 0xC612062576589DDAULL, 0x95364AFE032A819EULL },
+  { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL },
+  { 0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL },
+  { 0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL },
+  { 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL },
+  { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL },
+  { 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL },
+  { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL },
+  { 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL },
+  { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL },
+  { 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL },
+  { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL },
+  { 0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL },
+  { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL },
+  { 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL },
+  { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL },
+  { 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL },
+  { 0x89705F4136B4A597ULL, 0x31680A88F8953031ULL },
+  { 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL },
+  { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL },
+  { 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL },
+  { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL },
+  { 0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL },
+  { 0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL },
+  { 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL },
+  { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL },
+  { 0x8000000000000000ULL, 0x0000000000000000ULL },
+  { 0xA000000000000000ULL, 0x0000000000000000ULL },
+  { 0xC800000000000000ULL, 0x0000000000000000ULL },
+  { 0xFA00000000000000ULL, 0x0000000000000000ULL },
+  { 0x9C40000000000000ULL, 0x0000000000000000ULL },
+  { 0xC350000000000000ULL, 0x0000000000000000ULL },
+  { 0xF424000000000000ULL, 0x0000000000000000ULL },
+  { 0x9896800000000000ULL, 0x0000000000000000ULL },
+  { 0xBEBC200000000000ULL, 0x0000000000000000ULL },
+  { 0xEE6B280000000000ULL, 0x0000000000000000ULL },
+  { 0x9502F90000000000ULL, 0x0000000000000000ULL },
+  { 0xBA43B74000000000ULL, 0x0000000000000000ULL },
+  { 0xE8D4A51000000000ULL, 0x0000000000000000ULL },
+  { 0x9184E72A00000000ULL, 0x0000000000000000ULL },
+  { 0xB5E620F480000000ULL, 0x0000000000000000ULL },
+  { 0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+  { 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL },
+  { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+  { 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL },
+  { 0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+  { 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL },
+  { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+  { 0x878678326EAC9000ULL, 0x0000000000000000ULL },
+  { 0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+  { 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL },
+  { 0x84595161401484A0ULL, 0x0000000000000000ULL },
+  { 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL },
+  { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+  { 0x813F3978F8940984ULL, 0x4000000000000000ULL },
+  { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+  { 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL },
+  { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL },
+  { 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL },
+  { 0xC5371912364CE305ULL, 0x6C28000000000000ULL },
+  { 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL },
+  { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL },
+  { 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL },
+  { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL },
+  { 0x96769950B50D88F4ULL, 0x1314448000000000ULL },
+  { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL },
+  { 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL },
+  { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL },
+  { 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL },
+  { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL },
+  { 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL },
+  { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL },
+  { 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL },
+  { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL },
+  { 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL },
+  { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL },
+  { 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL },
+  { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL },
+  { 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL },
+  { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL },
+  { 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL },
+  { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL },
+  { 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL },
+  { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL },
+  { 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL },
+  { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL },
+  { 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL },
+  { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL },
+  { 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL },
+  { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL },
+  { 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL },
+  { 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL },
+  { 0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL },
+  { 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL },
+  { 0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL },
+  { 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL },
+  { 0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL },
+  { 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL },
+  { 0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL },
+  { 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL },
+  { 0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL },
+  { 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL },
+  { 0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL },
+  { 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL },
+  { 0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL },
+  { 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL },
+  { 0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL },
+  { 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL },
+  { 0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL },
+  { 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL },
+  { 0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL },
+  { 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL },
+  { 0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL },
+  { 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL },
+  { 0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL },
+  { 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL },
+  { 0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL },
+  { 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL },
+  { 0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL },
+  { 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL },
+  { 0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL },
+  { 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL },
+  { 0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL },
+  { 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL },
+  { 0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL },
+  { 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL },
+  { 0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL },
+  { 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL },
+  { 0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL },
+  { 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL },
+  { 0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL },
+  { 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL },
+  { 0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL },
+  { 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL },
+  { 0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL },
+  { 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL },
+  { 0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL },
+  { 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL },
+  { 0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL },
+  { 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL },
+  { 0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL },
+  { 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL },
+  { 0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL },
+  { 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL },
+  { 0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL },
+  { 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL },
+  { 0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL },
+  { 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL },
+  { 0x9AE757596946075FULL, 0x3375788DE9B06958ULL },
+  { 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL },
+  { 0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL },
+  { 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL },
+  { 0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL },
+  { 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL },
+  { 0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL },
+  { 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL },
+  { 0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL },
+  { 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL },
+  { 0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL },
+  { 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL },
+  { 0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL },
+  { 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL },
+  { 0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL },
+  { 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL },
+  { 0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL },
+  { 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL },
+  { 0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL },
+  { 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL },
+  { 0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL },
+  { 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL },
+  { 0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL },
+  { 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL },
+  { 0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL },
+  { 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL },
+  { 0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL },
+  { 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL },
+  { 0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL },
+  { 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL },
+  { 0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL },
+  { 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL },
+  { 0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL },
+  { 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL },
+  { 0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL },
+  { 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL },
+  { 0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL },
+  { 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL },
+  { 0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL },
+  { 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL },
+  { 0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL },
+  { 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL },
+  { 0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL },
+  { 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL },
+  { 0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL },
+  { 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL },
+  { 0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL },
+  { 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL },
+  { 0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL },
+  { 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL },
+  { 0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL },
+  { 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL },
+  { 0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL },
+  { 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL },
+  { 0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL },
+  { 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL },
+  { 0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL },
+  { 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL },
+  { 0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL },
+  { 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL },
+  { 0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL },
+  { 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL },
+  { 0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL },
+  { 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL },
+  { 0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL },
+  { 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL },
+  { 0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL },
+  { 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL },
+  { 0x8FA475791A569D10ULL, 0xF96E017D694487BCULL },
+  { 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL },
+  { 0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL },
+  { 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL },
+  { 0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL },
+  { 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL },
+  { 0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL },
+  { 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL },
+  { 0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL },
+  { 0x85C7056562757456ULL, 0xF6872D5667844E49ULL },
+  { 0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL },
+  { 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL },
+  { 0x82A45B450226B39CULL, 0xECC0024661173473ULL },
+  { 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL },
+  { 0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL },
+  { 0xFF290242C83396CEULL, 0x7E67047175A15271ULL },
+  { 0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL },
+  { 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL },
+  { 0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL },
+  { 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL },
+  { 0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL },
+  { 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL },
+  { 0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL },
+  { 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL },
+  { 0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL },
+  { 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL },
+  { 0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL },
+  { 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL },
+  { 0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL },
+  { 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL },
+  { 0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL },
+  { 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL },
+  { 0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL },
+  { 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL },
+  { 0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL },
+  { 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL },
+  { 0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL },
+  { 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL },
+  { 0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL },
+  { 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL },
+  { 0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL },
+  { 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL },
+  { 0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL },
+  { 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL },
+  { 0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL },
+  { 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL },
+  { 0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL },
+  { 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL },
+  { 0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL },
+  { 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL },
+  { 0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL },
+  { 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL },
+  { 0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL },
+  { 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL },
+  { 0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL },
+  { 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL },
+  { 0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL },
+  { 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL },
+  { 0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL },
+  { 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL },
+  { 0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL },
+  { 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL },
+  { 0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL },
+  { 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL },
+  { 0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL },
+  { 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL },
+  { 0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL },
+  { 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL },
+  { 0x8533285C936B35DEULL, 0xD53A88958F87275FULL },
+  { 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL },
+  { 0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL },
+  { 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL },
+  { 0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL },
+  { 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL },
+  { 0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL },
+  { 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL },
+  { 0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL },
+  { 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL },
+  { 0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL },
+  { 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL },
+  { 0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL },
+  { 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL },
+  { 0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL },
+  { 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL },
+  { 0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL },
+  { 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL },
+  { 0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL },
+  { 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL },
+  { 0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL },
+  { 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL },
+  { 0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL },
+  { 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL },
+  { 0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL },
+  { 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL },
+  { 0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL },
+  { 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL },
+  { 0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL },
+  { 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL },
+  { 0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL },
+  { 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL },
+  { 0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL },
+  { 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL },
+  { 0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL },
+  { 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL },
+  { 0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL },
+  { 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL },
+  { 0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL },
+  { 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL },
+  { 0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL },
+  { 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL },
+  { 0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL },
+  { 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL },
+  { 0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL },
+  { 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL },
+  { 0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL },
+  { 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL },
+  { 0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL },
+  { 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL },
+  { 0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL },
+  { 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL },
+  { 0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL },
+  { 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL },
+  { 0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL },
+  { 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL },
+  { 0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL },
+  { 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL },
+  { 0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL },
+  { 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL },
+  { 0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL },
+  { 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL },
+  { 0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL },
+  { 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL },
+  { 0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL },
+  { 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL },
+  { 0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL },
+  { 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL }
+};
+
+#define STR_POW5_MIN    -342
+#define STR_POW5_BITS   125
+
+static inline U64 STR_Multiply128(U64 left, U64 right, U64 *high)
+{
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = (unsigned __int128)left * right;
+  *high = (U64)(product >> 64);
+  return (U64)product;
+#elif defined(CC_MSVC) && defined(ARCH_X64)
+  return _umul128(left, right, high);
+#else
+  U64 ll = (U64)(U32)left * (U32)right, lh = (U64)(U32)left * (right >> 32);
+  U64 hl = (left >> 32) * (U32)right, hh = (left >> 32) * (right >> 32);
+  U64 middle = (ll >> 32) + (U32)lh + (U32)hl;
+  *high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+  return (middle << 32) | (U32)ll;
+#endif
+}
+
+static inline S32 STR_Pow5Bits(S32 e)
+{
+  return ((e * 1217359) >> 19) + 1;
+}
+
+static inline U32 STR_Log10Pow2(S32 e)
+{
+  return (U32)((e * 78913) >> 18);
+}
+
+static inline U32 STR_Log10Pow5(S32 e)
+{
+  return (U32)((e * 732923) >> 20);
+}
+
+/* 5^i with 125 bits, { low, high } */
+static inline void STR_Pow5(U32 i, U64 *result)
+{
+  const U64 *power = STR_POW5_128[i - STR_POW5_MIN];
+  result[0] = (power[1] >> 3) | (power[0] << 61);
+  result[1] = power[0] >> 3;
+}
+
+/* 2^(pow5bits(i) + 124) / 5^i + 1, { low, high } */
+static inline void STR_Pow5Inverse(U32 i, U64 *result)
+{
+  if (!i)
+  {
+    result[0] = 1;
+    result[1] = (U64)1 << 61;
+    return;
+  }
+  const U64 *power = STR_POW5_128[STR_POW5_MIN * -1 - i];
+  U64 up = i <= 27, low = power[1] - up, high = power[0] - (power[1] < up);
+  result[0] = ((low >> 3) | (high << 61)) + 1;
+  result[1] = (high >> 3) + !result[0];
+}
+
+static inline bool STR_MultipleOfPow5(U64 value, U32 p)
+{
+  U32 count = 0;
+  for (; value % 5 == 0; value /= 5) ++count;
+  return count >= p;
+}
+
+#define STR_MultipleOfPow2(value, p) (!((value) & (((U64)1 << (p)) - 1)))
+
+static inline U64 STR_MulShift64(U64 m, const U64 *mul, S32 j)
+{
+  U64 high0, high1;
+  STR_Multiply128(m, mul[0], &high0);
+  U64 sum = STR_Multiply128(m, mul[1], &high1) + high0;
+  high1 += sum < high0;
+  U32 shift = (U32)(j - 64);
+  return (sum >> shift) | (high1 << (64 - shift));
+}
+
+static inline U32 STR_MulShift32(U32 m, U64 factor, S32 j)
+{
+  U64 sum = (((U64)m * (U32)factor) >> 32) + (U64)m * (factor >> 32);
+  return (U32)(sum >> (j - 32));
+}
+
+/* Ryu, value = digits * 10^exponent for a finite non-zero value */
+static S32 STR_ShortestF64(U64 bits, U64 *digits)
+{
+  U64 mantissa = bits & (((U64)1 << 52) - 1);
+  U32 exponent = (U32)(bits >> 52) & 0x7FF;
+  U64 m2 = mantissa | ((U64)!!exponent << 52);
+  S32 e2 = (exponent ? (S32)exponent : 1) - 1075;
+  if (e2 <= 0 && e2 >= -52 && exponent && !(m2 & (((U64)1 << -e2) - 1)))
+  {
+    /* small integers are exact, only their trailing zeros need to go */
+    S32 e10 = 0;
+    for (m2 >>= -e2; m2 % 10 == 0; m2 /= 10) ++e10;
+    *digits = m2;
+    return e10;
+  }
+  e2 -= 2;
+  bool even = !(m2 & 1);
+  U64 mv = m2 << 2;
+  U32 mm_shift = mantissa || exponent <= 1;
+  U64 vr, vp, vm, mul[2];
+  S32 e10;
+  bool vm_zeros = false, vr_zeros = false;
+  if (e2 >= 0)
+  {
+    U32 q = STR_Log10Pow2(e2) - (e2 > 3);
+    S32 i = -e2 + (S32)q + STR_POW5_BITS + STR_Pow5Bits((S32)q) - 1;
+    e10 = (S32)q;
+    STR_Pow5Inverse(q, mul);
+    vr = STR_MulShift64(mv, mul, i);
+    vp = STR_MulShift64(mv + 2, mul, i);
+    vm = STR_MulShift64(mv - 1 - mm_shift, mul, i);
+    if (q <= 21)
+    {
+      if (mv % 5 == 0) vr_zeros = STR_MultipleOfPow5(mv, q);
+      else if (even) vm_zeros = STR_MultipleOfPow5(mv - 1 - mm_shift, q);
+      else vp -= STR_MultipleOfPow5(mv + 2, q);
+    }
+  }
+  else
+  {
+    U32 q = STR_Log10Pow5(-e2) - (-e2 > 1);
+    S32 i = -e2 - (S32)q;
+    S32 j = (S32)q - (STR_Pow5Bits(i) - STR_POW5_BITS);
+    e10 = (S32)q + e2;
+    STR_Pow5((U32)i, mul);
+    vr = STR_MulShift64(mv, mul, j);
+    vp = STR_MulShift64(mv + 2, mul, j);
+    vm = STR_MulShift64(mv - 1 - mm_shift, mul, j);
+    if (q <= 1)
+    {
+      vr_zeros = true;
+      if (even) vm_zeros = mm_shift == 1;
+      else --vp;
+    }
+    else if (q < 63) vr_zeros = STR_MultipleOfPow2(mv, q);
+  }
+
+  U64 output;
+  U8 last = 0;
+  if (vm_zeros || vr_zeros)
+  {
+    for (; vp / 10 > vm / 10; ++e10)
+    {
+      vm_zeros &= vm % 10 == 0;
+      vr_zeros &= last == 0;
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    if (vm_zeros) for (; vm % 10 == 0; ++e10)
+    {
+      vr_zeros &= last == 0;
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    if (vr_zeros && last == 5 && vr % 2 == 0) last = 4;
+    output = vr + ((vr == vm && (!even || !vm_zeros)) || last >= 5);
+  }
+  else
+  {
+    if (vp / 100 > vm / 100)
+    {
+      last = vr % 100 >= 50 ? 5 : 0;
+      vr /= 100;
+      vp /= 100;
+      vm /= 100;
+      e10 += 2;
+    }
+    for (; vp / 10 > vm / 10; ++e10)
+    {
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    output = vr + (vr == vm || last >= 5);
+  }
+  *digits = output;
+  return e10;
+}
+
+/* Ryu for binary32, with the binary64 multipliers cut to 64 bits */
+static S32 STR_ShortestF32(U32 bits, U64 *digits)
+{
+  U32 mantissa = bits & ((1u << 23) - 1);
+  U32 exponent = (bits >> 23) & 0xFF;
+  U32 m2 = mantissa | ((U32)!!exponent << 23);
+  S32 e2 = (exponent ? (S32)exponent : 1) - 152;
+  bool even = !(m2 & 1);
+  U32 mv = m2 << 2, mp = mv + 2, mm_shift = mantissa || exponent <= 1, mm = mv - 1 - mm_shift;
+  U32 vr, vp, vm;
+  U64 mul[2];
+  S32 e10;
+  bool vm_zeros = false, vr_zeros = false;
+  U8 last = 0;
+  if (e2 >= 0)
+  {
+    U32 q = STR_Log10Pow2(e2);
+    S32 i = -e2 + (S32)q + STR_POW5_BITS - 64 + STR_Pow5Bits((S32)q) - 1;
+    e10 = (S32)q;
+    STR_Pow5Inverse(q, mul);
+    vr = STR_MulShift32(mv, mul[1] + 1, i);
+    vp = STR_MulShift32(mp, mul[1] + 1, i);
+    vm = STR_MulShift32(mm, mul[1] + 1, i);
+    if (q && (vp - 1) / 10 <= vm / 10)
+    {
+      /* one removed digit is needed even if the loop below removes none */
+      S32 l = STR_POW5_BITS - 64 + STR_Pow5Bits((S32)q - 1) - 1;
+      STR_Pow5Inverse(q - 1, mul);
+      last = (U8)(STR_MulShift32(mv, mul[1] + 1, -e2 + (S32)q - 1 + l) % 10);
+    }
+    if (q <= 9)
+    {
+      if (mv % 5 == 0) vr_zeros = STR_MultipleOfPow5(mv, q);
+      else if (even) vm_zeros = STR_MultipleOfPow5(mm, q);
+      else vp -= STR_MultipleOfPow5(mp, q);
+    }
+  }
+  else
+  {
+    U32 q = STR_Log10Pow5(-e2);
+    S32 i = -e2 - (S32)q;
+    S32 j = (S32)q - (STR_Pow5Bits(i) - (STR_POW5_BITS - 64));
+    e10 = (S32)q + e2;
+    STR_Pow5((U32)i, mul);
+    vr = STR_MulShift32(mv, mul[1], j);
+    vp = STR_MulShift32(mp, mul[1], j);
+    vm = STR_MulShift32(mm, mul[1], j);
+    if (q && (vp - 1) / 10 <= vm / 10)
+    {
+      j = (S32)q - 1 - (STR_Pow5Bits(i + 1) - (STR_POW5_BITS - 64));
+      STR_Pow5((U32)i + 1, mul);
+      last = (U8)(STR_MulShift32(mv, mul[1], j) % 10);
+    }
+    if (q <= 1)
+    {
+      vr_zeros = true;
+      if (even) vm_zeros = mm_shift == 1;
+      else --vp;
+    }
+    else if (q < 31) vr_zeros = STR_MultipleOfPow2(mv, q - 1);
+  }
+
+  if (vm_zeros || vr_zeros)
+  {
+    for (; vp / 10 > vm / 10; ++e10)
+    {
+      vm_zeros &= vm % 10 == 0;
+      vr_zeros &= last == 0;
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    if (vm_zeros) for (; vm % 10 == 0; ++e10)
+    {
+      vr_zeros &= last == 0;
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    if (vr_zeros && last == 5 && vr % 2 == 0) last = 4;
+    *digits = vr + ((vr == vm && (!even || !vm_zeros)) || last >= 5);
+  }
+  else
+  {
+    for (; vp / 10 > vm / 10; ++e10)
+    {
+      last = (U8)(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+    }
+    *digits = vr + (vr == vm || last >= 5);
+  }
+  return e10;
+}
+
+/*
+ * Arbitrary precision decimal for the inputs Eisel-Lemire cannot decide and
+ * for exact fixed point output. Values are shifted by powers of two until the
+ * binary exponent is known, the digits are kept as values rather than ASCII.
+ */
+#define STR_DECIMAL_DIGITS    800
+#define STR_DECIMAL_MAX_SHIFT 60
+
+typedef struct STR_Decimal
+{
+  S32 count;
+  S32 point;
+  bool truncated;
+  U8 digits[STR_DECIMAL_DIGITS + 20];
+} STR_Decimal;
+
+static void STR_DecimalTrim(STR_Decimal *decimal)
+{
+  while (decimal->count && !decimal->digits[decimal->count - 1]) --decimal->count;
+  if (!decimal->count) decimal->point = 0;
+}
+
+static void STR_DecimalAssign(STR_Decimal *decimal, U64 value)
+{
+  U8 digits[20];
+  S32 size = 0;
+  for (; value; value /= 10) digits[size++] = (U8)(value % 10);
+  for (decimal->count = 0; size;) decimal->digits[decimal->count++] = digits[--size];
+  decimal->point = decimal->count;
+  decimal->truncated = false;
+  STR_DecimalTrim(decimal);
+}
+
+static void STR_DecimalShiftRight(STR_Decimal *decimal, U32 shift)
+{
+  S32 read = 0, write = 0;
+  U64 n = 0, mask = ((U64)1 << shift) - 1;
+  for (; !(n >> shift); ++read)
+  {
+    if (read >= decimal->count)
+    {
+      for (; !(n >> shift); ++read) n *= 10;
+      break;
+    }
+    n = n * 10 + decimal->digits[read];
+  }
+  decimal->point -= read - 1;
+  for (; read < decimal->count; ++read)
+  {
+    decimal->digits[write++] = (U8)(n >> shift);
+    n = (n & mask) * 10 + decimal->digits[read];
+  }
+  for (; n; n = (n & mask) * 10)
+  {
+    if (write < STR_DECIMAL_DIGITS) decimal->digits[write++] = (U8)(n >> shift);
+    else if (n >> shift) decimal->truncated = true;
+  }
+  decimal->count = write;
+  STR_DecimalTrim(decimal);
+}
+
+static void STR_DecimalShiftLeft(STR_Decimal *decimal, U32 shift)
+{
+  /* leave room for every digit 2^shift can add and drop the unused ones after */
+  S32 added = (S32)STR_Log10Pow2((S32)shift) + 1;
+  S32 write = decimal->count + added;
+  U64 n = 0;
+  for (S32 read = decimal->count; read--; n /= 10)
+  {
+    n += (U64)decimal->digits[read] << shift;
+    decimal->digits[--write] = (U8)(n % 10);
+  }
+  for (; n; n /= 10) decimal->digits[--write] = (U8)(n % 10);
+  added -= write;
+  MemoryCopy(decimal->digits, decimal->digits + write, decimal->count + added);
+  decimal->count += added;
+  decimal->point += added;
+  for (; decimal->count > STR_DECIMAL_DIGITS; --decimal->count)
+  {
+    if (decimal->digits[decimal->count - 1]) decimal->truncated = true;
+  }
+  STR_DecimalTrim(decimal);
+}
+
+static void STR_DecimalShift(STR_Decimal *decimal, S32 shift)
+{
+  if (!decimal->count) return;
+  for (; shift > STR_DECIMAL_MAX_SHIFT; shift -= STR_DECIMAL_MAX_SHIFT) STR_DecimalShiftLeft(decimal, STR_DECIMAL_MAX_SHIFT);
+  for (; shift < -STR_DECIMAL_MAX_SHIFT; shift += STR_DECIMAL_MAX_SHIFT) STR_DecimalShiftRight(decimal, STR_DECIMAL_MAX_SHIFT);
+  if (shift > 0) STR_DecimalShiftLeft(decimal, (U32)shift);
+  else if (shift < 0) STR_DecimalShiftRight(decimal, (U32)-shift);
+}
+
+static bool STR_DecimalRoundsUp(STR_Decimal *decimal, S32 count)
+{
+  if (count < 0 || count >= decimal->count) return false;
+  if (decimal->digits[count] == 5 && count + 1 == decimal->count)
+  {
+    /* exactly halfway rounds to even unless digits were dropped */
+    return decimal->truncated || (count > 0 && (decimal->digits[count - 1] & 1));
+  }
+  return decimal->digits[count] >= 5;
+}
+
+static void STR_DecimalRound(STR_Decimal *decimal, S32 count)
+{
+  if (count < 0 || count >= decimal->count) return;
+  if (STR_DecimalRoundsUp(decimal, count))
+  {
+    for (S32 i = count - 1; i >= 0; --i)
+    {
+      if (decimal->digits[i] < 9)
+      {
+        ++decimal->digits[i];
+        decimal->count = i + 1;
+        return;
+      }
+    }
+    decimal->digits[0] = 1;
+    decimal->count = 1;
+    ++decimal->point;
+  }
+  else
+  {
+    decimal->count = count;
+    STR_DecimalTrim(decimal);
+  }
+}
+
+typedef struct STR_FloatFormat
+{
+  U32 mantissa_bits;
+  U32 exponent_bits;
+  S32 bias;
+  S32 min_power;
+  S32 max_power;
+  S32 min_round_even;
+  S32 max_round_even;
+} STR_FloatFormat;
+
+static const STR_FloatFormat STR_FORMAT_F64 = { 52, 11, -1023, -342, 308, -4, 23 };
+static const STR_FloatFormat STR_FORMAT_F32 = { 23, 8, -127, -65, 38, -17, 10 };
+
+static U64 STR_DecimalToBits(STR_Decimal *decimal, const STR_FloatFormat *format)
+{
+  static const U8 shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+  S32 infinite = (1 << format->exponent_bits) - 1, exponent = format->bias;
+  U64 mantissa = 0;
+  if (decimal->point > 310) exponent += infinite;
+  else if (decimal->count && decimal->point >= -330)
+  {
+    /* scale into [0.5, 1) */
+    for (exponent = 0; decimal->point > 0;)
+    {
+      S32 shift = decimal->point < (S32)ArrayLength(shifts) ? shifts[decimal->point] : 27;
+      STR_DecimalShift(decimal, -shift);
+      exponent += shift;
+    }
+    while (decimal->point < 0 || (!decimal->point && decimal->digits[0] < 5))
+    {
+      S32 shift = -decimal->point < (S32)ArrayLength(shifts) ? shifts[-decimal->point] : 27;
+      STR_DecimalShift(decimal, shift);
+      exponent -= shift;
+    }
+    if (--exponent < format->bias + 1)
+    {
+      STR_DecimalShift(decimal, exponent - format->bias - 1);
+      exponent = format->bias + 1;
+    }
+    if (exponent - format->bias < infinite)
+    {
+      STR_DecimalShift(decimal, (S32)format->mantissa_bits + 1);
+      mantissa = 0;
+      S32 i = 0;
+      for (; i < decimal->point && i < decimal->count; ++i) mantissa = mantissa * 10 + decimal->digits[i];
+      for (; i < decimal->point; ++i) mantissa *= 10;
+      mantissa += STR_DecimalRoundsUp(decimal, decimal->point);
+      if (mantissa == (U64)2 << format->mantissa_bits)
+      {
+        mantissa >>= 1;
+        ++exponent;
+      }
+      if (!(mantissa & ((U64)1 << format->mantissa_bits))) exponent = format->bias;
+    }
+    if (exponent - format->bias >= infinite)
+    {
+      mantissa = 0;
+      exponent = format->bias + infinite;
+    }
+  }
+  return (mantissa & (((U64)1 << format->mantissa_bits) - 1)) | ((U64)(exponent - format->bias) << format->mantissa_bits);
+}
+
+/* returns the biased exponent, the mantissa has its implicit bit cleared */
+static S32 STR_EiselLemire(S64 q, U64 w, const STR_FloatFormat *format, U64 *mantissa)
+{
+  S32 infinite = (1 << format->exponent_bits) - 1;
+  *mantissa = 0;
+  if (!w || q < format->min_power) return 0;
+  if (q > format->max_power) return infinite;
+  U32 zeros = CountLeadingZeros64(w);
+  w <<= zeros;
+  const U64 *power = STR_POW5_128[q - STR_POW5_MIN];
+  U64 precision = MAX_U64 >> (format->mantissa_bits + 3), high, low = STR_Multiply128(w, power[0], &high);
+  if ((high & precision) == precision)
+  {
+    U64 second;
+    STR_Multiply128(w, power[1], &second);
+    low += second;
+    high += second > low;
+  }
+  U32 upper = (U32)(high >> 63), shift = upper + 64 - format->mantissa_bits - 3;
+  U64 m = high >> shift;
+  S32 exponent = (S32)(((152170 + 65536) * (S32)q) >> 16) + 63 + (S32)upper - (S32)zeros - format->bias;
+  if (exponent <= 0)
+  {
+    /* subnormal, unless rounding carries into the smallest normal */
+    if (-exponent + 1 >= 64) return 0;
+    m >>= -exponent + 1;
+    m += m & 1;
+    m >>= 1;
+    *mantissa = m & ~((U64)1 << format->mantissa_bits);
+    return m >= ((U64)1 << format->mantissa_bits);
+  }
+  if (low <= 1 && q >= format->min_round_even && q <= format->max_round_even && (m & 3) == 1 && (m << shift) == high)
+  {
+    /* exactly halfway, round down to even */
+    m &= ~(U64)1;
+  }
+  m += m & 1;
+  m >>= 1;
+  if (m >= ((U64)2 << format->mantissa_bits))
+  {
+    m = (U64)1 << format->mantissa_bits;
+    ++exponent;
+  }
+  if (exponent >= infinite) return infinite;
+  *mantissa = m & ~((U64)1 << format->mantissa_bits);
+  return exponent;
+}
+
+#define STR_IsDigit(c) ((U8)((c) - '0') < 10)
+
+static bool STR_MatchNoCase(STR string, UZ offset, const char *word)
+{
+  for (; *word; ++word, ++offset)
+  {
+    if (offset >= string.size || (string.str[offset] | 0x20) != *word) return false;
+  }
+  return true;
+}
+
+static const U64 STR_DIGIT_THRESHOLDS[20] =
+{
+  0ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+  100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+  10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+static const char STR_DIGIT_PAIRS[201] =
+  "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+  "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+static inline UZ STR_CountDigits(U64 value)
+{
+  /* log10 estimated from the bit length, corrected with one comparison */
+  U32 guess = ((64 - CountLeadingZeros64(value | 1)) * 1233) >> 12;
+  return guess + 1 - (value < STR_DIGIT_THRESHOLDS[guess]);
+}
+
+static inline void STR_WriteDigitPairs(U8 *end, U32 value, U32 pairs)
+{
+  for (; pairs; --pairs, value /= 100)
+  {
+    const char *pair = STR_DIGIT_PAIRS + (value % 100) * 2;
+    *--end = (U8)pair[1];
+    *--end = (U8)pair[0];
+  }
+}
+
+/* writes the digits of the value into exactly count bytes */
+static void STR_WriteDigits(U8 *buffer, U64 value, UZ count)
+{
+  U8 *end = buffer + count;
+  while (value >= 100000000)
+  {
+    /* eight digits at a time with 32-bit divisions */
+    STR_WriteDigitPairs(end, (U32)(value % 100000000), 4);
+    value /= 100000000;
+    end -= 8;
+  }
+  U32 low = (U32)value;
+  for (; low >= 100; low /= 100, end -= 2) STR_WriteDigitPairs(end, low % 100, 1);
+  if (low >= 10) STR_WriteDigitPairs(end, low, 1);
+  else *--end = (U8)('0' + low);
+}
+
+static inline U64 STR_Load64(const U8 *data)
+{
+  U64 chunk;
+  MemoryCopy(&chunk, data, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  chunk = ByteSwap64(chunk);
+#endif
+  return chunk;
+}
+
+static inline U32 STR_Load32(const U8 *data)
+{
+  U32 chunk;
+  MemoryCopy(&chunk, data, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  chunk = ByteSwap32(chunk);
+#endif
+  return chunk;
+}
+
+static inline bool STR_IsEightDigits(U64 chunk)
+{
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/* SWAR: pairs, then quads, then the eight digits, all in one register */
+static inline U32 STR_ParseEightDigits(U64 chunk)
+{
+  chunk -= 0x3030303030303030ULL;
+  chunk = chunk * 10 + (chunk >> 8);
+  chunk = ((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) + ((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+  return (U32)chunk;
+}
+
+UZ STR_ParseU64(STR string, U64 *value)
+{
+  UZ i = 0, start;
+  U64 result = 0, chunk;
+  while (i < string.size && string.str[i] == '0') ++i;
+  start = i;
+  /* 19 digits never overflow, only the 20th needs a check */
+  for (; i - start <= 11 && i + 8 <= string.size && STR_IsEightDigits(chunk = STR_Load64(string.str + i)); i += 8)
+  {
+    result = result * 100000000 + STR_ParseEightDigits(chunk);
+  }
+  for (; i < string.size && STR_IsDigit(string.str[i]); ++i)
+  {
+    U64 digit = string.str[i] - '0';
+    if (i - start >= 19 && (i - start > 19 || result > (MAX_U64 - digit) / 10)) return 0;
+    result = result * 10 + digit;
+  }
+  if (i) *value = result;
+  return i;
+}
+
+UZ STR_ParseS64(STR string, S64 *value)
+{
+  UZ sign = string.size && (string.str[0] == '-' || string.str[0] == '+');
+  bool negative = sign && string.str[0] == '-';
+  U64 magnitude;
+  UZ size = STR_ParseU64((STR) { string.str + sign, string.size - sign }, &magnitude);
+  if (!size || magnitude > (U64)MAX_S64 + negative) return 0;
+  *value = negative ? (S64)(0 - magnitude) : (S64)magnitude;
+  return size + sign;
+}
+
+UZ STR_FormatU64(U8 *buffer, UZ capacity, U64 value)
+{
+  UZ size = STR_CountDigits(value);
+  if (size > capacity) return 0;
+  STR_WriteDigits(buffer, value, size);
+  return size;
+}
+
+UZ STR_FormatS64(U8 *buffer, UZ capacity, S64 value)
+{
+  U64 magnitude = value < 0 ? 0 - (U64)value : (U64)value;
+  UZ sign = value < 0, size = STR_CountDigits(magnitude) + sign;
+  if (size > capacity) return 0;
+  if (sign) buffer[0] = '-';
+  STR_WriteDigits(buffer + sign, magnitude, size - sign);
+  return size;
+}
+
+STR STR_From_U64(MEM *mem, U64 value)
+{
+  U8 buffer[STR_U64_MAX_SIZE];
+  return STR_Copy(mem, (STR) { buffer, STR_FormatU64(buffer, sizeof(buffer), value) });
+}
+
+STR STR_From_S64(MEM *mem, S64 value)
+{
+  U8 buffer[STR_S64_MAX_SIZE];
+  return STR_Copy(mem, (STR) { buffer, STR_FormatS64(buffer, sizeof(buffer), value) });
+}
+
+static const F64 STR_POW10_F64[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static const F32 STR_POW10_F32[] =
+{
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+/* parses the float syntax into the bits of the format, returns the bytes consumed */
+static UZ STR_ParseFloat(STR string, const STR_FloatFormat *format, U64 *bits)
+{
+  UZ i = 0;
+  bool negative = i < string.size && string.str[i] == '-';
+  if (i < string.size && (string.str[i] == '-' || string.str[i] == '+')) ++i;
+  U64 sign = (U64)negative << (format->mantissa_bits + format->exponent_bits);
+  U64 infinite = (((U64)1 << format->exponent_bits) - 1) << format->mantissa_bits;
+  if (STR_MatchNoCase(string, i, "inf"))
+  {
+    *bits = sign | infinite;
+    return i + (STR_MatchNoCase(string, i, "infinity") ? 8 : 3);
+  }
+  if (STR_MatchNoCase(string, i, "nan"))
+  {
+    *bits = sign | infinite | ((U64)1 << (format->mantissa_bits - 1));
+    return i + 3;
+  }
+
+  UZ start = i, integer_end, end;
+  U64 w = 0;
+  for (; i < string.size && STR_IsDigit(string.str[i]); ++i) w = w * 10 + (string.str[i] - '0');
+  integer_end = i;
+  if (i < string.size && string.str[i] == '.')
+  {
+    U64 chunk;
+    for (++i; i + 8 <= string.size && STR_IsEightDigits(chunk = STR_Load64(string.str + i)); i += 8)
+    {
+      w = w * 100000000 + STR_ParseEightDigits(chunk);
+    }
+    for (; i < string.size && STR_IsDigit(string.str[i]); ++i) w = w * 10 + (string.str[i] - '0');
+  }
+  end = i;
+  S64 fraction = end > integer_end ? (S64)(end - integer_end - 1) : 0;
+  S64 digits = (S64)(integer_end - start) + fraction, explicit = 0;
+  if (!digits) return 0;
+  if (i < string.size && (string.str[i] | 0x20) == 'e')
+  {
+    UZ j = i + 1;
+    bool negative_exponent = j < string.size && string.str[j] == '-';
+    if (j < string.size && (string.str[j] == '-' || string.str[j] == '+')) ++j;
+    if (j < string.size && STR_IsDigit(string.str[j]))
+    {
+      for (; j < string.size && STR_IsDigit(string.str[j]); ++j)
+      {
+        if (explicit < 0x10000) explicit = explicit * 10 + (string.str[j] - '0');
+      }
+      if (negative_exponent) explicit = -explicit;
+      i = j;
+    }
+  }
+
+  S64 exponent = explicit - fraction;
+  bool many = false;
+  if (digits > 19)
+  {
+    /* leading zeros are not significant */
+    for (UZ j = start; j < end && (string.str[j] == '0' || string.str[j] == '.'); ++j) digits -= string.str[j] == '0';
+    if (digits > 19)
+    {
+      /* keep the first 19 digits, which still round correctly if w and w + 1 agree */
+      UZ j = start;
+      many = true;
+      for (w = 0; j < end && w < 1000000000000000000ULL; ++j)
+      {
+        if (string.str[j] != '.') w = w * 10 + (string.str[j] - '0');
+      }
+      exponent = explicit + (j <= integer_end ? (S64)(integer_end - j) : -(S64)(j - integer_end - 1));
+    }
+  }
+
+#if FLT_EVAL_METHOD == 0
+  /* Clinger: both w and 10^|exponent| are exact, so is the single rounding */
+  S64 fast = format->mantissa_bits == 52 ? 22 : 10;
+  if (!many && exponent >= -fast && exponent <= fast && w <= ((U64)2 << format->mantissa_bits))
+  {
+    if (format->mantissa_bits == 52)
+    {
+      F64 value = (F64)w;
+      value = exponent < 0 ? value / STR_POW10_F64[-exponent] : value * STR_POW10_F64[exponent];
+      MemoryCopy(bits, &value, sizeof(value));
+    }
+    else
+    {
+      U32 value32;
+      F32 value = (F32)w;
+      value = exponent < 0 ? value / STR_POW10_F32[-exponent] : value * STR_POW10_F32[exponent];
+      MemoryCopy(&value32, &value, sizeof(value));
+      *bits = value32;
+    }
+    *bits |= sign;
+    return i;
+  }
+#endif
+
+  U64 mantissa, other;
+  S32 power = STR_EiselLemire(exponent, w, format, &mantissa);
+  if (many && (power != STR_EiselLemire(exponent, w + 1, format, &other) || mantissa != other))
+  {
+    STR_Decimal decimal;
+    S64 seen = 0, point = 0;
+    decimal.truncated = false;
+    for (UZ j = start; j < end; ++j)
+    {
+      if (string.str[j] == '.')
+      {
+        point = seen;
+        continue;
+      }
+      U8 digit = (U8)(string.str[j] - '0');
+      if (!digit && !seen) --point;
+      else
+      {
+        if (seen < STR_DECIMAL_DIGITS) decimal.digits[seen] = digit;
+        else if (digit) decimal.truncated = true;
+        ++seen;
+      }
+    }
+    if (end == integer_end) point = seen;
+    point += explicit;
+    decimal.count = (S32)Min(seen, STR_DECIMAL_DIGITS);
+    decimal.point = (S32)Clamp(-100000, point, 100000);
+    STR_DecimalTrim(&decimal);
+    *bits = sign | STR_DecimalToBits(&decimal, format);
+  }
+  else *bits = sign | mantissa | ((U64)power << format->mantissa_bits);
+  return i;
+}
+
+UZ STR_ParseF64(STR string, F64 *value)
+{
+  U64 bits;
+  UZ size = STR_ParseFloat(string, &STR_FORMAT_F64, &bits);
+  if (size) MemoryCopy(value, &bits, sizeof(*value));
+  return size;
+}
+
+UZ STR_ParseF32(STR string, F32 *value)
+{
+  U64 bits;
+  UZ size = STR_ParseFloat(string, &STR_FORMAT_F32, &bits);
+  if (size)
+  {
+    U32 bits32 = (U32)bits;
+    MemoryCopy(value, &bits32, sizeof(*value));
+  }
+  return size;
+}
+
+/* writes nan and inf, returns 0 for finite values */
+static UZ STR_WriteSpecial(U8 *buffer, U64 bits, const STR_FloatFormat *format)
+{
+  U64 infinite = (((U64)1 << format->exponent_bits) - 1) << format->mantissa_bits;
+  if ((bits & infinite) != infinite) return 0;
+  STR text = bits & (((U64)1 << format->mantissa_bits) - 1) ? STR_Static("nan")
+    : bits >> (format->mantissa_bits + format->exponent_bits) ? STR_Static("-inf") : STR_Static("inf");
+  MemoryCopy(buffer, text.str, text.size);
+  return text.size;
+}
+
+/* shortest digits in the notation of JavaScript: fixed for 1e-7 <= |value| < 1e21 */
+static UZ STR_WriteShortest(U8 *buffer, U64 bits, const STR_FloatFormat *format)
+{
+  U8 *out = buffer, text[20];
+  UZ size = STR_WriteSpecial(buffer, bits, format);
+  if (size) return size;
+  if (bits >> (format->mantissa_bits + format->exponent_bits)) *out++ = '-';
+  U64 digits = 0;
+  S32 exponent = 0;
+  if (bits & (((U64)1 << (format->mantissa_bits + format->exponent_bits)) - 1))
+  {
+    exponent = format->mantissa_bits == 52 ? STR_ShortestF64(bits, &digits) : STR_ShortestF32((U32)bits, &digits);
+  }
+  S32 count = (S32)STR_CountDigits(digits), point = exponent + count;
+  STR_WriteDigits(text, digits, count);
+  if (point >= count && point <= 21)
+  {
+    MemoryCopy(out, text, count);
+    memset(out + count, '0', point - count);
+    out += point;
+  }
+  else if (point > 0 && point <= 21)
+  {
+    MemoryCopy(out, text, point);
+    out[point] = '.';
+    MemoryCopy(out + point + 1, text + point, count - point);
+    out += count + 1;
+  }
+  else if (point > -6 && point <= 0)
+  {
+    *out++ = '0';
+    *out++ = '.';
+    memset(out, '0', -point);
+    MemoryCopy(out - point, text, count);
+    out += count - point;
+  }
+  else
+  {
+    *out++ = text[0];
+    if (count > 1)
+    {
+      *out++ = '.';
+      MemoryCopy(out, text + 1, count - 1);
+      out += count - 1;
+    }
+    *out++ = 'e';
+    *out++ = point > 0 ? '+' : '-';
+    U32 e = (U32)Abs(point - 1);
+    UZ size = STR_CountDigits(e);
+    STR_WriteDigits(out, e, size);
+    out += size;
+  }
+  return (UZ)(out - buffer);
+}
+
+UZ STR_FormatF64(U8 *buffer, UZ capacity, F64 value)
+{
+  U8 local[STR_F64_MAX_SIZE];
+  U64 bits;
+  MemoryCopy(&bits, &value, sizeof(bits));
+  if (capacity >= STR_F64_MAX_SIZE) return STR_WriteShortest(buffer, bits, &STR_FORMAT_F64);
+  UZ size = STR_WriteShortest(local, bits, &STR_FORMAT_F64);
+  if (size > capacity) return 0;
+  MemoryCopy(buffer, local, size);
+  return size;
+}
+
+UZ STR_FormatF32(U8 *buffer, UZ capacity, F32 value)
+{
+  U8 local[STR_F32_MAX_SIZE];
+  U32 bits;
+  MemoryCopy(&bits, &value, sizeof(bits));
+  if (capacity >= STR_F32_MAX_SIZE) return STR_WriteShortest(buffer, bits, &STR_FORMAT_F32);
+  UZ size = STR_WriteShortest(local, bits, &STR_FORMAT_F32);
+  if (size > capacity) return 0;
+  MemoryCopy(buffer, local, size);
+  return size;
+}
+
+/* rounds the exact value to the precision, returns the size of the fixed notation */
+static UZ STR_FixedDecimal(STR_Decimal *decimal, U64 bits, U32 precision)
+{
+  U64 mantissa = bits & (((U64)1 << 52) - 1);
+  S32 exponent = (S32)(bits >> 52) & 0x7FF;
+  decimal->count = 0;
+  decimal->point = 0;
+  decimal->truncated = false;
+  if (mantissa || exponent)
+  {
+    U64 digits;
+    S32 e10 = STR_ShortestF64(bits, &digits), count = (S32)STR_CountDigits(digits);
+    if (-e10 <= (S64)precision && (S64)e10 + count + precision <= 15)
+    {
+      /* fewer than 16 significant digits, the shortest digits are the exact ones rounded */
+      STR_DecimalAssign(decimal, digits);
+      decimal->point += e10;
+    }
+    else
+    {
+      STR_DecimalAssign(decimal, mantissa | ((U64)!!exponent << 52));
+      STR_DecimalShift(decimal, (exponent ? exponent : 1) - 1075);
+      STR_DecimalRound(decimal, (S32)Min((S64)decimal->point + precision, (S64)decimal->count));
+    }
+  }
+  return (UZ)(bits >> 63) + (UZ)Max(decimal->point, 1) + (precision ? (UZ)precision + 1 : 0);
+}
+
+static void STR_WriteFixed(U8 *out, const STR_Decimal *decimal, U64 bits, U32 precision)
+{
+  if (bits >> 63) *out++ = '-';
+  if (decimal->point <= 0) *out++ = '0';
+  for (S32 i = 0; i < decimal->point; ++i) *out++ = (U8)('0' + (i < decimal->count ? decimal->digits[i] : 0));
+  if (precision)
+  {
+    *out++ = '.';
+    for (S64 i = decimal->point, end = i + precision; i < end; ++i)
+    {
+      *out++ = (U8)('0' + (i >= 0 && i < decimal->count ? decimal->digits[i] : 0));
+    }
+  }
+}
+
+UZ STR_FormatF64Fixed(U8 *buffer, UZ capacity, F64 value, U32 precision)
+{
+  U8 local[4];
+  U64 bits;
+  MemoryCopy(&bits, &value, sizeof(bits));
+  UZ size = STR_WriteSpecial(local, bits, &STR_FORMAT_F64);
+  if (size)
+  {
+    if (size > capacity) return 0;
+    MemoryCopy(buffer, local, size);
+    return size;
+  }
+  STR_Decimal decimal;
+  size = STR_FixedDecimal(&decimal, bits, precision);
+  if (size > capacity) return 0;
+  STR_WriteFixed(buffer, &decimal, bits, precision);
+  return size;
+}
+
+STR STR_From_F64(MEM *mem, F64 value)
+{
+  U8 buffer[STR_F64_MAX_SIZE];
+  return STR_Copy(mem, (STR) { buffer, STR_FormatF64(buffer, sizeof(buffer), value) });
+}
+
+STR STR_From_F32(MEM *mem, F32 value)
+{
+  U8 buffer[STR_F32_MAX_SIZE];
+  return STR_Copy(mem, (STR) { buffer, STR_FormatF32(buffer, sizeof(buffer), value) });
+}
+
+static const U8 STR_BASE64_DIGITS[2][65] =
+{
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+static const U8 STR_HEX_DIGITS[17] = "0123456789abcdef";
+
+static const U8 STR_BASE64_VALUES[2][256] =
+{
+  {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  },
+  {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+  }
+};
+
+static const U8 STR_HEX_VALUES[256] =
+{
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+#if defined(SIMD_AVX2)
+/* Spreads 24 bytes (12 per lane) into 32 6-bit indices and maps them to their digits. */
+static inline __m256i STR_Base64EncodeBlock(__m256i input, __m256i shift)
+{
+  input = _mm256_shuffle_epi8(input, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+  __m256i low = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+  __m256i indices = _mm256_or_si256(high, low);
+  /* 0-25 select entry 13, 26-51 entry 0, 52-63 entries 1-12 of the shift table */
+  __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  reduced = _mm256_or_si256(reduced, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift, reduced));
+}
+
+/* Packs 32 digits into 24 bytes (12 per lane), returning false if any digit is not in the alphabet. */
+static inline bool STR_Base64DecodeBlock(__m256i input, __m256i digit62, __m256i digit63, __m256i *output)
+{
+  __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), input));
+  __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), input));
+  __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), input));
+  __m256i is62 = _mm256_cmpeq_epi8(input, digit62), is63 = _mm256_cmpeq_epi8(input, digit63);
+  __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(is62, is63)));
+  if ((U32)_mm256_movemask_epi8(valid) != MAX_U32) return false;
+  __m256i offset = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+  offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+  offset = _mm256_or_si256(offset, _mm256_and_si256(is62, _mm256_sub_epi8(_mm256_set1_epi8(62), digit62)));
+  offset = _mm256_or_si256(offset, _mm256_and_si256(is63, _mm256_sub_epi8(_mm256_set1_epi8(63), digit63)));
+  __m256i values = _mm256_add_epi8(input, offset);
+  values = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+  *output = _mm256_shuffle_epi8(values, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+/* Converts 32 hex digits to their values, returning false if any of them is not a hex digit. */
+static inline bool STR_HexDecodeBlock(__m256i input, __m256i *output)
+{
+  __m256i digit = _mm256_sub_epi8(input, _mm256_set1_epi8('0'));
+  __m256i letter = _mm256_sub_epi8(_mm256_or_si256(input, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+  if ((U32)_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != MAX_U32) return false;
+  __m256i values = _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+  *output = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+  return true;
+}
+#endif
+
+UZ STR_Base64EncodedSize(UZ size, STR_Base64 alphabet)
+{
+  return alphabet == STR_BASE64_URL ? size / 3 * 4 + (size % 3 * 4 + 2) / 3 : (size + 2) / 3 * 4;
+}
+
+/* Returns the number of digits without padding, or MAX_UZ if the size or the padding is malformed. */
+static UZ STR_Base64DigitCount(STR string)
+{
+  UZ size = string.size;
+  if (size && string.str[size - 1] == '=') --size;
+  if (size && string.str[size - 1] == '=') --size;
+  if ((size != string.size && string.size % 4) || size % 4 == 1) return MAX_UZ;
+  return size;
+}
+
+UZ STR_Base64DecodedSize(STR string)
+{
+  UZ size = STR_Base64DigitCount(string);
+  return size == MAX_UZ ? 0 : size / 4 * 3 + size % 4 * 3 / 4;
+}
+
+UZ STR_Base64Encode(U8 *buffer, UZ capacity, STR data, STR_Base64 alphabet)
+{
+  UZ size = STR_Base64EncodedSize(data.size, alphabet), i = 0;
+  if (size > capacity) return 0;
+  const U8 *digits = STR_BASE64_DIGITS[alphabet == STR_BASE64_URL], *in = data.str;
+  U8 *out = buffer;
+#if defined(SIMD_AVX2)
+  __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, (char)(digits[62] - 62), (char)(digits[63] - 63), 'A', 0, 0,
+    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, (char)(digits[62] - 62), (char)(digits[63] - 63), 'A', 0, 0);
+  /* each lane reads 16 bytes and encodes 12 of them */
+  for (; i + 28 <= data.size; i += 24, out += 32)
+  {
+    __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(in + i))),
+      _mm_loadu_si128((const __m128i*)(in + i + 12)), 1);
+    _mm256_storeu_si256((__m256i*)out, STR_Base64EncodeBlock(input, shift));
+  }
+#endif
+  for (; i + 3 <= data.size; i += 3, out += 4)
+  {
+    U32 word = (U32)in[i] << 16 | (U32)in[i + 1] << 8 | in[i + 2];
+    out[0] = digits[word >> 18];
+    out[1] = digits[(word >> 12) & 63];
+    out[2] = digits[(word >> 6) & 63];
+    out[3] = digits[word & 63];
+  }
+  if (i < data.size)
+  {
+    U32 word = (U32)in[i] << 16 | (i + 1 < data.size ? (U32)in[i + 1] << 8 : 0);
+    *out++ = digits[word >> 18];
+    *out++ = digits[(word >> 12) & 63];
+    if (i + 1 < data.size) *out++ = digits[(word >> 6) & 63];
+    else if (alphabet != STR_BASE64_URL) *out++ = '=';
+    if (alphabet != STR_BASE64_URL) *out = '=';
+  }
+  return size;
+}
+
+static bool STR_Base64DecodeDigits(U8 *out, const U8 *in, UZ size, STR_Base64 alphabet)
+{
+  const U8 *values = STR_BASE64_VALUES[alphabet == STR_BASE64_URL];
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  const U8 *digits = STR_BASE64_DIGITS[alphabet == STR_BASE64_URL];
+  __m256i digit62 = _mm256_set1_epi8((char)digits[62]), digit63 = _mm256_set1_epi8((char)digits[63]);
+  /* every block stores 32 bytes, so leave enough digits for the 8 bytes past its output */
+  for (__m256i block; i + 44 <= size; i += 32, out += 24)
+  {
+    if (!STR_Base64DecodeBlock(_mm256_loadu_si256((const __m256i*)(in + i)), digit62, digit63, &block)) break;
+    _mm256_storeu_si256((__m256i*)out, _mm256_permutevar8x32_epi32(block, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+  }
+#endif
+  for (; i + 4 <= size; i += 4, out += 3)
+  {
+    U32 a = values[in[i]], b = values[in[i + 1]], c = values[in[i + 2]], d = values[in[i + 3]];
+    if ((a | b | c | d) & 0x80) return false;
+    U32 word = a << 18 | b << 12 | c << 6 | d;
+    out[0] = (U8)(word >> 16);
+    out[1] = (U8)(word >> 8);
+    out[2] = (U8)word;
+  }
+  if (i < size)
+  {
+    U32 a = values[in[i]], b = values[in[i + 1]], c = i + 2 < size ? values[in[i + 2]] : 0;
+    if ((a | b | c) & 0x80) return false;
+    U32 word = a << 18 | b << 12 | c << 6;
+    out[0] = (U8)(word >> 16);
+    if (i + 2 < size) out[1] = (U8)(word >> 8);
+  }
+  return true;
+}
+
+UZ STR_Base64Decode(U8 *buffer, UZ capacity, STR string, STR_Base64 alphabet)
+{
+  UZ digits = STR_Base64DigitCount(string);
+  if (digits == MAX_UZ) return 0;
+  UZ size = digits / 4 * 3 + digits % 4 * 3 / 4;
+  if (size > capacity || !STR_Base64DecodeDigits(buffer, string.str, digits, alphabet)) return 0;
+  return size;
+}
+
+STR STR_To_Base64(MEM *mem, STR data, STR_Base64 alphabet)
+{
+  STR result = STR_Allocate(mem, STR_Base64EncodedSize(data.size, alphabet));
+  if (result.str) STR_Base64Encode(result.str, result.size, data, alphabet);
+  return result;
+}
+
+STR STR_From_Base64(MEM *mem, STR string, STR_Base64 alphabet)
+{
+  UZ digits = STR_Base64DigitCount(string);
+  if (digits == MAX_UZ) return (STR) { 0 };
+  STR result = STR_Allocate(mem, digits / 4 * 3 + digits % 4 * 3 / 4);
+  if (result.str && !STR_Base64DecodeDigits(result.str, string.str, digits, alphabet))
+  {
+    MEM_Deallocate(mem, result.str);
+    return (STR) { 0 };
+  }
+  return result;
+}
+
+UZ STR_HexEncode(U8 *buffer, UZ capacity, STR data)
+{
+  UZ i = 0;
+  if (data.size > capacity / 2) return 0;
+  U8 *out = buffer;
+#if defined(SIMD_AVX2)
+  __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)STR_HEX_DIGITS));
+  for (; i + 32 <= data.size; i += 32, out += 64)
+  {
+    __m256i input = _mm256_loadu_si256((const __m256i*)(data.str + i));
+    __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F)));
+    __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(input, _mm256_set1_epi8(0x0F)));
+    __m256i first = _mm256_unpacklo_epi8(high, low), second = _mm256_unpackhi_epi8(high, low);
+    _mm256_storeu_si256((__m256i*)out, _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256((__m256i*)(out + 32), _mm256_permute2x128_si256(first, second, 0x31));
+  }
+#endif
+  for (; i < data.size; ++i, out += 2)
+  {
+    out[0] = STR_HEX_DIGITS[data.str[i] >> 4];
+    out[1] = STR_HEX_DIGITS[data.str[i] & 15];
+  }
+  return data.size * 2;
+}
+
+static bool STR_HexDecodeDigits(U8 *out, const U8 *in, UZ size)
+{
+  UZ i = 0;
+#if defined(SIMD_AVX2)
+  for (__m256i first, second; i + 64 <= size; i += 64, out += 32)
+  {
+    if (!STR_HexDecodeBlock(_mm256_loadu_si256((const __m256i*)(in + i)), &first)) break;
+    if (!STR_HexDecodeBlock(_mm256_loadu_si256((const __m256i*)(in + i + 32)), &second)) break;
+    _mm256_storeu_si256((__m256i*)out, _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xD8));
+  }
+#endif
+  for (; i < size; i += 2, ++out)
+  {
+    U32 high = STR_HEX_VALUES[in[i]], low = STR_HEX_VALUES[in[i + 1]];
+    if ((high | low) & 0x80) return false;
+    *out = (U8)(high << 4 | low);
+  }
+  return true;
+}
+
+UZ STR_HexDecode(U8 *buffer, UZ capacity, STR string)
+{
+  if (string.size % 2 || string.size / 2 > capacity || !STR_HexDecodeDigits(buffer, string.str, string.size)) return 0;
+  return string.size / 2;
+}
+
+STR STR_To_Hex(MEM *mem, STR data)
+{
+  STR result = STR_Allocate(mem, data.size * 2);
+  if (result.str) STR_HexEncode(result.str, result.size, data);
+  return result;
+}
+
+STR STR_From_Hex(MEM *mem, STR string)
+{
+  if (string.size % 2) return (STR) { 0 };
+  STR result = STR_Allocate(mem, string.size / 2);
+  if (result.str && !STR_HexDecodeDigits(result.str, string.str, string.size))
+  {
+    MEM_Deallocate(mem, result.str);
+    return (STR) { 0 };
+  }
+  return result;
+}
+
+#if !defined(SIMD_SSE42) && !defined(SIMD_ARM_CRC32)
+static const U32 STR_CRC32C_TABLE[8][256] =
+{
+  {
+    0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8, 0xD4CA64EB,
+    0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24,
+    0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+    0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B,
+    0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+    0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+    0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+    0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595,
+    0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+    0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+    0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38,
+    0xDBFC821C, 0x2997011F, 0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+    0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789,
+    0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+    0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+    0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829,
+    0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93,
+    0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+    0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC,
+    0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+    0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+    0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81, 0xFC588982,
+    0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622,
+    0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+    0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+    0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0,
+    0xD3D3E1AB, 0x21B862A8, 0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+    0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+    0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1,
+    0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+    0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69, 0xD5CF889D, 0x27A40B9E,
+    0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351
+  },
+  {
+    0x00000000, 0x13A29877, 0x274530EE, 0x34E7A899, 0x4E8A61DC, 0x5D28F9AB, 0x69CF5132, 0x7A6DC945,
+    0x9D14C3B8, 0x8EB65BCF, 0xBA51F356, 0xA9F36B21, 0xD39EA264, 0xC03C3A13, 0xF4DB928A, 0xE7790AFD,
+    0x3FC5F181, 0x2C6769F6, 0x1880C16F, 0x0B225918, 0x714F905D, 0x62ED082A, 0x560AA0B3, 0x45A838C4,
+    0xA2D13239, 0xB173AA4E, 0x859402D7, 0x96369AA0, 0xEC5B53E5, 0xFFF9CB92, 0xCB1E630B, 0xD8BCFB7C,
+    0x7F8BE302, 0x6C297B75, 0x58CED3EC, 0x4B6C4B9B, 0x310182DE, 0x22A31AA9, 0x1644B230, 0x05E62A47,
+    0xE29F20BA, 0xF13DB8CD, 0xC5DA1054, 0xD6788823, 0xAC154166, 0xBFB7D911, 0x8B507188, 0x98F2E9FF,
+    0x404E1283, 0x53EC8AF4, 0x670B226D, 0x74A9BA1A, 0x0EC4735F, 0x1D66EB28, 0x298143B1, 0x3A23DBC6,
+    0xDD5AD13B, 0xCEF8494C, 0xFA1FE1D5, 0xE9BD79A2, 0x93D0B0E7, 0x80722890, 0xB4958009, 0xA737187E,
+    0xFF17C604, 0xECB55E73, 0xD852F6EA, 0xCBF06E9D, 0xB19DA7D8, 0xA23F3FAF, 0x96D89736, 0x857A0F41,
+    0x620305BC, 0x71A19DCB, 0x45463552, 0x56E4AD25, 0x2C896460, 0x3F2BFC17, 0x0BCC548E, 0x186ECCF9,
+    0xC0D23785, 0xD370AFF2, 0xE797076B, 0xF4359F1C, 0x8E585659, 0x9DFACE2E, 0xA91D66B7, 0xBABFFEC0,
+    0x5DC6F43D, 0x4E646C4A, 0x7A83C4D3, 0x69215CA4, 0x134C95E1, 0x00EE0D96, 0x3409A50F, 0x27AB3D78,
+    0x809C2506, 0x933EBD71, 0xA7D915E8, 0xB47B8D9F, 0xCE1644DA, 0xDDB4DCAD, 0xE9537434, 0xFAF1EC43,
+    0x1D88E6BE, 0x0E2A7EC9, 0x3ACDD650, 0x296F4E27, 0x53028762, 0x40A01F15, 0x7447B78C, 0x67E52FFB,
+    0xBF59D487, 0xACFB4CF0, 0x981CE469, 0x8BBE7C1E, 0xF1D3B55B, 0xE2712D2C, 0xD69685B5, 0xC5341DC2,
+    0x224D173F, 0x31EF8F48, 0x050827D1, 0x16AABFA6, 0x6CC776E3, 0x7F65EE94, 0x4B82460D, 0x5820DE7A,
+    0xFBC3FAF9, 0xE861628E, 0xDC86CA17, 0xCF245260, 0xB5499B25, 0xA6EB0352, 0x920CABCB, 0x81AE33BC,
+    0x66D73941, 0x7575A136, 0x419209AF, 0x523091D8, 0x285D589D, 0x3BFFC0EA, 0x0F186873, 0x1CBAF004,
+    0xC4060B78, 0xD7A4930F, 0xE3433B96, 0xF0E1A3E1, 0x8A8C6AA4, 0x992EF2D3, 0xADC95A4A, 0xBE6BC23D,
+    0x5912C8C0, 0x4AB050B7, 0x7E57F82E, 0x6DF56059, 0x1798A91C, 0x043A316B, 0x30DD99F2, 0x237F0185,
+    0x844819FB, 0x97EA818C, 0xA30D2915, 0xB0AFB162, 0xCAC27827, 0xD960E050, 0xED8748C9, 0xFE25D0BE,
+    0x195CDA43, 0x0AFE4234, 0x3E19EAAD, 0x2DBB72DA, 0x57D6BB9F, 0x447423E8, 0x70938B71, 0x63311306,
+    0xBB8DE87A, 0xA82F700D, 0x9CC8D894, 0x8F6A40E3, 0xF50789A6, 0xE6A511D1, 0xD242B948, 0xC1E0213F,
+    0x26992BC2, 0x353BB3B5, 0x01DC1B2C, 0x127E835B, 0x68134A1E, 0x7BB1D269, 0x4F567AF0, 0x5CF4E287,
+    0x04D43CFD, 0x1776A48A, 0x23910C13, 0x30339464, 0x4A5E5D21, 0x59FCC556, 0x6D1B6DCF, 0x7EB9F5B8,
+    0x99C0FF45, 0x8A626732, 0xBE85CFAB, 0xAD2757DC, 0xD74A9E99, 0xC4E806EE, 0xF00FAE77, 0xE3AD3600,
+    0x3B11CD7C, 0x28B3550B, 0x1C54FD92, 0x0FF665E5, 0x759BACA0, 0x663934D7, 0x52DE9C4E, 0x417C0439,
+    0xA6050EC4, 0xB5A796B3, 0x81403E2A, 0x92E2A65D, 0xE88F6F18, 0xFB2DF76F, 0xCFCA5FF6, 0xDC68C781,
+    0x7B5FDFFF, 0x68FD4788, 0x5C1AEF11, 0x4FB87766, 0x35D5BE23, 0x26772654, 0x12908ECD, 0x013216BA,
+    0xE64B1C47, 0xF5E98430, 0xC10E2CA9, 0xD2ACB4DE, 0xA8C17D9B, 0xBB63E5EC, 0x8F844D75, 0x9C26D502,
+    0x449A2E7E, 0x5738B609, 0x63DF1E90, 0x707D86E7, 0x0A104FA2, 0x19B2D7D5, 0x2D557F4C, 0x3EF7E73B,
+    0xD98EEDC6, 0xCA2C75B1, 0xFECBDD28, 0xED69455F, 0x97048C1A, 0x84A6146D, 0xB041BCF4, 0xA3E32483
+  },
+  {
+    0x00000000, 0xA541927E, 0x4F6F520D, 0xEA2EC073, 0x9EDEA41A, 0x3B9F3664, 0xD1B1F617, 0x74F06469,
+    0x38513EC5, 0x9D10ACBB, 0x773E6CC8, 0xD27FFEB6, 0xA68F9ADF, 0x03CE08A1, 0xE9E0C8D2, 0x4CA15AAC,
+    0x70A27D8A, 0xD5E3EFF4, 0x3FCD2F87, 0x9A8CBDF9, 0xEE7CD990, 0x4B3D4BEE, 0xA1138B9D, 0x045219E3,
+    0x48F3434F, 0xEDB2D131, 0x079C1142, 0xA2DD833C, 0xD62DE755, 0x736C752B, 0x9942B558, 0x3C032726,
+    0xE144FB14, 0x4405696A, 0xAE2BA919, 0x0B6A3B67, 0x7F9A5F0E, 0xDADBCD70, 0x30F50D03, 0x95B49F7D,
+    0xD915C5D1, 0x7C5457AF, 0x967A97DC, 0x333B05A2, 0x47CB61CB, 0xE28AF3B5, 0x08A433C6, 0xADE5A1B8,
+    0x91E6869E, 0x34A714E0, 0xDE89D493, 0x7BC846ED, 0x0F382284, 0xAA79B0FA, 0x40577089, 0xE516E2F7,
+    0xA9B7B85B, 0x0CF62A25, 0xE6D8EA56, 0x43997828, 0x37691C41, 0x92288E3F, 0x78064E4C, 0xDD47DC32,
+    0xC76580D9, 0x622412A7, 0x880AD2D4, 0x2D4B40AA, 0x59BB24C3, 0xFCFAB6BD, 0x16D476CE, 0xB395E4B0,
+    0xFF34BE1C, 0x5A752C62, 0xB05BEC11, 0x151A7E6F, 0x61EA1A06, 0xC4AB8878, 0x2E85480B, 0x8BC4DA75,
+    0xB7C7FD53, 0x12866F2D, 0xF8A8AF5E, 0x5DE93D20, 0x29195949, 0x8C58CB37, 0x66760B44, 0xC337993A,
+    0x8F96C396, 0x2AD751E8, 0xC0F9919B, 0x65B803E5, 0x1148678C, 0xB409F5F2, 0x5E273581, 0xFB66A7FF,
+    0x26217BCD, 0x8360E9B3, 0x694E29C0, 0xCC0FBBBE, 0xB8FFDFD7, 0x1DBE4DA9, 0xF7908DDA, 0x52D11FA4,
+    0x1E704508, 0xBB31D776, 0x511F1705, 0xF45E857B, 0x80AEE112, 0x25EF736C, 0xCFC1B31F, 0x6A802161,
+    0x56830647, 0xF3C29439, 0x19EC544A, 0xBCADC634, 0xC85DA25D, 0x6D1C3023, 0x8732F050, 0x2273622E,
+    0x6ED23882, 0xCB93AAFC, 0x21BD6A8F, 0x84FCF8F1, 0xF00C9C98, 0x554D0EE6, 0xBF63CE95, 0x1A225CEB,
+    0x8B277743, 0x2E66E53D, 0xC448254E, 0x6109B730, 0x15F9D359, 0xB0B84127, 0x5A968154, 0xFFD7132A,
+    0xB3764986, 0x1637DBF8, 0xFC191B8B, 0x595889F5, 0x2DA8ED9C, 0x88E97FE2, 0x62C7BF91, 0xC7862DEF,
+    0xFB850AC9, 0x5EC498B7, 0xB4EA58C4, 0x11ABCABA, 0x655BAED3, 0xC01A3CAD, 0x2A34FCDE, 0x8F756EA0,
+    0xC3D4340C, 0x6695A672, 0x8CBB6601, 0x29FAF47F, 0x5D0A9016, 0xF84B0268, 0x1265C21B, 0xB7245065,
+    0x6A638C57, 0xCF221E29, 0x250CDE5A, 0x804D4C24, 0xF4BD284D, 0x51FCBA33, 0xBBD27A40, 0x1E93E83E,
+    0x5232B292, 0xF77320EC, 0x1D5DE09F, 0xB81C72E1, 0xCCEC1688, 0x69AD84F6, 0x83834485, 0x26C2D6FB,
+    0x1AC1F1DD, 0xBF8063A3, 0x55AEA3D0, 0xF0EF31AE, 0x841F55C7, 0x215EC7B9, 0xCB7007CA, 0x6E3195B4,
+    0x2290CF18, 0x87D15D66, 0x6DFF9D15, 0xC8BE0F6B, 0xBC4E6B02, 0x190FF97C, 0xF321390F, 0x5660AB71,
+    0x4C42F79A, 0xE90365E4, 0x032DA597, 0xA66C37E9, 0xD29C5380, 0x77DDC1FE, 0x9DF3018D, 0x38B293F3,
+    0x7413C95F, 0xD1525B21, 0x3B7C9B52, 0x9E3D092C, 0xEACD6D45, 0x4F8CFF3B, 0xA5A23F48, 0x00E3AD36,
+    0x3CE08A10, 0x99A1186E, 0x738FD81D, 0xD6CE4A63, 0xA23E2E0A, 0x077FBC74, 0xED517C07, 0x4810EE79,
+    0x04B1B4D5, 0xA1F026AB, 0x4BDEE6D8, 0xEE9F74A6, 0x9A6F10CF, 0x3F2E82B1, 0xD50042C2, 0x7041D0BC,
+    0xAD060C8E, 0x08479EF0, 0xE2695E83, 0x4728CCFD, 0x33D8A894, 0x96993AEA, 0x7CB7FA99, 0xD9F668E7,
+    0x9557324B, 0x3016A035, 0xDA386046, 0x7F79F238, 0x0B899651, 0xAEC8042F, 0x44E6C45C, 0xE1A75622,
+    0xDDA47104, 0x78E5E37A, 0x92CB2309, 0x378AB177, 0x437AD51E, 0xE63B4760, 0x0C158713, 0xA954156D,
+    0xE5F54FC1, 0x40B4DDBF, 0xAA9A1DCC, 0x0FDB8FB2, 0x7B2BEBDB, 0xDE6A79A5, 0x3444B9D6, 0x91052BA8
+  },
+  {
+    0x00000000, 0xDD45AAB8, 0xBF672381, 0x62228939, 0x7B2231F3, 0xA6679B4B, 0xC4451272, 0x1900B8CA,
+    0xF64463E6, 0x2B01C95E, 0x49234067, 0x9466EADF, 0x8D665215, 0x5023F8AD, 0x32017194, 0xEF44DB2C,
+    0xE964B13D, 0x34211B85, 0x560392BC, 0x8B463804, 0x924680CE, 0x4F032A76, 0x2D21A34F, 0xF06409F7,
+    0x1F20D2DB, 0xC2657863, 0xA047F15A, 0x7D025BE2, 0x6402E328, 0xB9474990, 0xDB65C0A9, 0x06206A11,
+    0xD725148B, 0x0A60BE33, 0x6842370A, 0xB5079DB2, 0xAC072578, 0x71428FC0, 0x136006F9, 0xCE25AC41,
+    0x2161776D, 0xFC24DDD5, 0x9E0654EC, 0x4343FE54, 0x5A43469E, 0x8706EC26, 0xE524651F, 0x3861CFA7,
+    0x3E41A5B6, 0xE3040F0E, 0x81268637, 0x5C632C8F, 0x45639445, 0x98263EFD, 0xFA04B7C4, 0x27411D7C,
+    0xC805C650, 0x15406CE8, 0x7762E5D1, 0xAA274F69, 0xB327F7A3, 0x6E625D1B, 0x0C40D422, 0xD1057E9A,
+    0xABA65FE7, 0x76E3F55F, 0x14C17C66, 0xC984D6DE, 0xD0846E14, 0x0DC1C4AC, 0x6FE34D95, 0xB2A6E72D,
+    0x5DE23C01, 0x80A796B9, 0xE2851F80, 0x3FC0B538, 0x26C00DF2, 0xFB85A74A, 0x99A72E73, 0x44E284CB,
+    0x42C2EEDA, 0x9F874462, 0xFDA5CD5B, 0x20E067E3, 0x39E0DF29, 0xE4A57591, 0x8687FCA8, 0x5BC25610,
+    0xB4868D3C, 0x69C32784, 0x0BE1AEBD, 0xD6A40405, 0xCFA4BCCF, 0x12E11677, 0x70C39F4E, 0xAD8635F6,
+    0x7C834B6C, 0xA1C6E1D4, 0xC3E468ED, 0x1EA1C255, 0x07A17A9F, 0xDAE4D027, 0xB8C6591E, 0x6583F3A6,
+    0x8AC7288A, 0x57828232, 0x35A00B0B, 0xE8E5A1B3, 0xF1E51979, 0x2CA0B3C1, 0x4E823AF8, 0x93C79040,
+    0x95E7FA51, 0x48A250E9, 0x2A80D9D0, 0xF7C57368, 0xEEC5CBA2, 0x3380611A, 0x51A2E823, 0x8CE7429B,
+    0x63A399B7, 0xBEE6330F, 0xDCC4BA36, 0x0181108E, 0x1881A844, 0xC5C402FC, 0xA7E68BC5, 0x7AA3217D,
+    0x52A0C93F, 0x8FE56387, 0xEDC7EABE, 0x30824006, 0x2982F8CC, 0xF4C75274, 0x96E5DB4D, 0x4BA071F5,
+    0xA4E4AAD9, 0x79A10061, 0x1B838958, 0xC6C623E0, 0xDFC69B2A, 0x02833192, 0x60A1B8AB, 0xBDE41213,
+    0xBBC47802, 0x6681D2BA, 0x04A35B83, 0xD9E6F13B, 0xC0E649F1, 0x1DA3E349, 0x7F816A70, 0xA2C4C0C8,
+    0x4D801BE4, 0x90C5B15C, 0xF2E73865, 0x2FA292DD, 0x36A22A17, 0xEBE780AF, 0x89C50996, 0x5480A32E,
+    0x8585DDB4, 0x58C0770C, 0x3AE2FE35, 0xE7A7548D, 0xFEA7EC47, 0x23E246FF, 0x41C0CFC6, 0x9C85657E,
+    0x73C1BE52, 0xAE8414EA, 0xCCA69DD3, 0x11E3376B, 0x08E38FA1, 0xD5A62519, 0xB784AC20, 0x6AC10698,
+    0x6CE16C89, 0xB1A4C631, 0xD3864F08, 0x0EC3E5B0, 0x17C35D7A, 0xCA86F7C2, 0xA8A47EFB, 0x75E1D443,
+    0x9AA50F6F, 0x47E0A5D7, 0x25C22CEE, 0xF8878656, 0xE1873E9C, 0x3CC29424, 0x5EE01D1D, 0x83A5B7A5,
+    0xF90696D8, 0x24433C60, 0x4661B559, 0x9B241FE1, 0x8224A72B, 0x5F610D93, 0x3D4384AA, 0xE0062E12,
+    0x0F42F53E, 0xD2075F86, 0xB025D6BF, 0x6D607C07, 0x7460C4CD, 0xA9256E75, 0xCB07E74C, 0x16424DF4,
+    0x106227E5, 0xCD278D5D, 0xAF050464, 0x7240AEDC, 0x6B401616, 0xB605BCAE, 0xD4273597, 0x09629F2F,
+    0xE6264403, 0x3B63EEBB, 0x59416782, 0x8404CD3A, 0x9D0475F0, 0x4041DF48, 0x22635671, 0xFF26FCC9,
+    0x2E238253, 0xF36628EB, 0x9144A1D2, 0x4C010B6A, 0x5501B3A0, 0x88441918, 0xEA669021, 0x37233A99,
+    0xD867E1B5, 0x05224B0D, 0x6700C234, 0xBA45688C, 0xA345D046, 0x7E007AFE, 0x1C22F3C7, 0xC167597F,
+    0xC747336E, 0x1A0299D6, 0x782010EF, 0xA565BA57, 0xBC65029D, 0x6120A825, 0x0302211C, 0xDE478BA4,
+    0x31035088, 0xEC46FA30, 0x8E647309, 0x5321D9B1, 0x4A21617B, 0x9764CBC3, 0xF54642FA, 0x2803E842
+  },
+  {
+    0x00000000, 0x38116FAC, 0x7022DF58, 0x4833B0F4, 0xE045BEB0, 0xD854D11C, 0x906761E8, 0xA8760E44,
+    0xC5670B91, 0xFD76643D, 0xB545D4C9, 0x8D54BB65, 0x2522B521, 0x1D33DA8D, 0x55006A79, 0x6D1105D5,
+    0x8F2261D3, 0xB7330E7F, 0xFF00BE8B, 0xC711D127, 0x6F67DF63, 0x5776B0CF, 0x1F45003B, 0x27546F97,
+    0x4A456A42, 0x725405EE, 0x3A67B51A, 0x0276DAB6, 0xAA00D4F2, 0x9211BB5E, 0xDA220BAA, 0xE2336406,
+    0x1BA8B557, 0x23B9DAFB, 0x6B8A6A0F, 0x539B05A3, 0xFBED0BE7, 0xC3FC644B, 0x8BCFD4BF, 0xB3DEBB13,
+    0xDECFBEC6, 0xE6DED16A, 0xAEED619E, 0x96FC0E32, 0x3E8A0076, 0x069B6FDA, 0x4EA8DF2E, 0x76B9B082,
+    0x948AD484, 0xAC9BBB28, 0xE4A80BDC, 0xDCB96470, 0x74CF6A34, 0x4CDE0598, 0x04EDB56C, 0x3CFCDAC0,
+    0x51EDDF15, 0x69FCB0B9, 0x21CF004D, 0x19DE6FE1, 0xB1A861A5, 0x89B90E09, 0xC18ABEFD, 0xF99BD151,
+    0x37516AAE, 0x0F400502, 0x4773B5F6, 0x7F62DA5A, 0xD714D41E, 0xEF05BBB2, 0xA7360B46, 0x9F2764EA,
+    0xF236613F, 0xCA270E93, 0x8214BE67, 0xBA05D1CB, 0x1273DF8F, 0x2A62B023, 0x625100D7, 0x5A406F7B,
+    0xB8730B7D, 0x806264D1, 0xC851D425, 0xF040BB89, 0x5836B5CD, 0x6027DA61, 0x28146A95, 0x10050539,
+    0x7D1400EC, 0x45056F40, 0x0D36DFB4, 0x3527B018, 0x9D51BE5C, 0xA540D1F0, 0xED736104, 0xD5620EA8,
+    0x2CF9DFF9, 0x14E8B055, 0x5CDB00A1, 0x64CA6F0D, 0xCCBC6149, 0xF4AD0EE5, 0xBC9EBE11, 0x848FD1BD,
+    0xE99ED468, 0xD18FBBC4, 0x99BC0B30, 0xA1AD649C, 0x09DB6AD8, 0x31CA0574, 0x79F9B580, 0x41E8DA2C,
+    0xA3DBBE2A, 0x9BCAD186, 0xD3F96172, 0xEBE80EDE, 0x439E009A, 0x7B8F6F36, 0x33BCDFC2, 0x0BADB06E,
+    0x66BCB5BB, 0x5EADDA17, 0x169E6AE3, 0x2E8F054F, 0x86F90B0B, 0xBEE864A7, 0xF6DBD453, 0xCECABBFF,
+    0x6EA2D55C, 0x56B3BAF0, 0x1E800A04, 0x269165A8, 0x8EE76BEC, 0xB6F60440, 0xFEC5B4B4, 0xC6D4DB18,
+    0xABC5DECD, 0x93D4B161, 0xDBE70195, 0xE3F66E39, 0x4B80607D, 0x73910FD1, 0x3BA2BF25, 0x03B3D089,
+    0xE180B48F, 0xD991DB23, 0x91A26BD7, 0xA9B3047B, 0x01C50A3F, 0x39D46593, 0x71E7D567, 0x49F6BACB,
+    0x24E7BF1E, 0x1CF6D0B2, 0x54C56046, 0x6CD40FEA, 0xC4A201AE, 0xFCB36E02, 0xB480DEF6, 0x8C91B15A,
+    0x750A600B, 0x4D1B0FA7, 0x0528BF53, 0x3D39D0FF, 0x954FDEBB, 0xAD5EB117, 0xE56D01E3, 0xDD7C6E4F,
+    0xB06D6B9A, 0x887C0436, 0xC04FB4C2, 0xF85EDB6E, 0x5028D52A, 0x6839BA86, 0x200A0A72, 0x181B65DE,
+    0xFA2801D8, 0xC2396E74, 0x8A0ADE80, 0xB21BB12C, 0x1A6DBF68, 0x227CD0C4, 0x6A4F6030, 0x525E0F9C,
+    0x3F4F0A49, 0x075E65E5, 0x4F6DD511, 0x777CBABD, 0xDF0AB4F9, 0xE71BDB55, 0xAF286BA1, 0x9739040D,
+    0x59F3BFF2, 0x61E2D05E, 0x29D160AA, 0x11C00F06, 0xB9B60142, 0x81A76EEE, 0xC994DE1A, 0xF185B1B6,
+    0x9C94B463, 0xA485DBCF, 0xECB66B3B, 0xD4A70497, 0x7CD10AD3, 0x44C0657F, 0x0CF3D58B, 0x34E2BA27,
+    0xD6D1DE21, 0xEEC0B18D, 0xA6F30179, 0x9EE26ED5, 0x36946091, 0x0E850F3D, 0x46B6BFC9, 0x7EA7D065,
+    0x13B6D5B0, 0x2BA7BA1C, 0x63940AE8, 0x5B856544, 0xF3F36B00, 0xCBE204AC, 0x83D1B458, 0xBBC0DBF4,
+    0x425B0AA5, 0x7A4A6509, 0x3279D5FD, 0x0A68BA51, 0xA21EB415, 0x9A0FDBB9, 0xD23C6B4D, 0xEA2D04E1,
+    0x873C0134, 0xBF2D6E98, 0xF71EDE6C, 0xCF0FB1C0, 0x6779BF84, 0x5F68D028, 0x175B60DC, 0x2F4A0F70,
+    0xCD796B76, 0xF56804DA, 0xBD5BB42E, 0x854ADB82, 0x2D3CD5C6, 0x152DBA6A, 0x5D1E0A9E, 0x650F6532,
+    0x081E60E7, 0x300F0F4B, 0x783CBFBF, 0x402DD013, 0xE85BDE57, 0xD04AB1FB, 0x9879010F, 0xA0686EA3
+  },
+  {
+    0x00000000, 0xEF306B19, 0xDB8CA0C3, 0x34BCCBDA, 0xB2F53777, 0x5DC55C6E, 0x697997B4, 0x8649FCAD,
+    0x6006181F, 0x8F367306, 0xBB8AB8DC, 0x54BAD3C5, 0xD2F32F68, 0x3DC34471, 0x097F8FAB, 0xE64FE4B2,
+    0xC00C303E, 0x2F3C5B27, 0x1B8090FD, 0xF4B0FBE4, 0x72F90749, 0x9DC96C50, 0xA975A78A, 0x4645CC93,
+    0xA00A2821, 0x4F3A4338, 0x7B8688E2, 0x94B6E3FB, 0x12FF1F56, 0xFDCF744F, 0xC973BF95, 0x2643D48C,
+    0x85F4168D, 0x6AC47D94, 0x5E78B64E, 0xB148DD57, 0x370121FA, 0xD8314AE3, 0xEC8D8139, 0x03BDEA20,
+    0xE5F20E92, 0x0AC2658B, 0x3E7EAE51, 0xD14EC548, 0x570739E5, 0xB83752FC, 0x8C8B9926, 0x63BBF23F,
+    0x45F826B3, 0xAAC84DAA, 0x9E748670, 0x7144ED69, 0xF70D11C4, 0x183D7ADD, 0x2C81B107, 0xC3B1DA1E,
+    0x25FE3EAC, 0xCACE55B5, 0xFE729E6F, 0x1142F576, 0x970B09DB, 0x783B62C2, 0x4C87A918, 0xA3B7C201,
+    0x0E045BEB, 0xE13430F2, 0xD588FB28, 0x3AB89031, 0xBCF16C9C, 0x53C10785, 0x677DCC5F, 0x884DA746,
+    0x6E0243F4, 0x813228ED, 0xB58EE337, 0x5ABE882E, 0xDCF77483, 0x33C71F9A, 0x077BD440, 0xE84BBF59,
+    0xCE086BD5, 0x213800CC, 0x1584CB16, 0xFAB4A00F, 0x7CFD5CA2, 0x93CD37BB, 0xA771FC61, 0x48419778,
+    0xAE0E73CA, 0x413E18D3, 0x7582D309, 0x9AB2B810, 0x1CFB44BD, 0xF3CB2FA4, 0xC777E47E, 0x28478F67,
+    0x8BF04D66, 0x64C0267F, 0x507CEDA5, 0xBF4C86BC, 0x39057A11, 0xD6351108, 0xE289DAD2, 0x0DB9B1CB,
+    0xEBF65579, 0x04C63E60, 0x307AF5BA, 0xDF4A9EA3, 0x5903620E, 0xB6330917, 0x828FC2CD, 0x6DBFA9D4,
+    0x4BFC7D58, 0xA4CC1641, 0x9070DD9B, 0x7F40B682, 0xF9094A2F, 0x16392136, 0x2285EAEC, 0xCDB581F5,
+    0x2BFA6547, 0xC4CA0E5E, 0xF076C584, 0x1F46AE9D, 0x990F5230, 0x763F3929, 0x4283F2F3, 0xADB399EA,
+    0x1C08B7D6, 0xF338DCCF, 0xC7841715, 0x28B47C0C, 0xAEFD80A1, 0x41CDEBB8, 0x75712062, 0x9A414B7B,
+    0x7C0EAFC9, 0x933EC4D0, 0xA7820F0A, 0x48B26413, 0xCEFB98BE, 0x21CBF3A7, 0x1577387D, 0xFA475364,
+    0xDC0487E8, 0x3334ECF1, 0x0788272B, 0xE8B84C32, 0x6EF1B09F, 0x81C1DB86, 0xB57D105C, 0x5A4D7B45,
+    0xBC029FF7, 0x5332F4EE, 0x678E3F34, 0x88BE542D, 0x0EF7A880, 0xE1C7C399, 0xD57B0843, 0x3A4B635A,
+    0x99FCA15B, 0x76CCCA42, 0x42700198, 0xAD406A81, 0x2B09962C, 0xC439FD35, 0xF08536EF, 0x1FB55DF6,
+    0xF9FAB944, 0x16CAD25D, 0x22761987, 0xCD46729E, 0x4B0F8E33, 0xA43FE52A, 0x90832EF0, 0x7FB345E9,
+    0x59F09165, 0xB6C0FA7C, 0x827C31A6, 0x6D4C5ABF, 0xEB05A612, 0x0435CD0B, 0x308906D1, 0xDFB96DC8,
+    0x39F6897A, 0xD6C6E263, 0xE27A29B9, 0x0D4A42A0, 0x8B03BE0D, 0x6433D514, 0x508F1ECE, 0xBFBF75D7,
+    0x120CEC3D, 0xFD3C8724, 0xC9804CFE, 0x26B027E7, 0xA0F9DB4A, 0x4FC9B053, 0x7B757B89, 0x94451090,
+    0x720AF422, 0x9D3A9F3B, 0xA98654E1, 0x46B63FF8, 0xC0FFC355, 0x2FCFA84C, 0x1B736396, 0xF443088F,
+    0xD200DC03, 0x3D30B71A, 0x098C7CC0, 0xE6BC17D9, 0x60F5EB74, 0x8FC5806D, 0xBB794BB7, 0x544920AE,
+    0xB206C41C, 0x5D36AF05, 0x698A64DF, 0x86BA0FC6, 0x00F3F36B, 0xEFC39872, 0xDB7F53A8, 0x344F38B1,
+    0x97F8FAB0, 0x78C891A9, 0x4C745A73, 0xA344316A, 0x250DCDC7, 0xCA3DA6DE, 0xFE816D04, 0x11B1061D,
+    0xF7FEE2AF, 0x18CE89B6, 0x2C72426C, 0xC3422975, 0x450BD5D8, 0xAA3BBEC1, 0x9E87751B, 0x71B71E02,
+    0x57F4CA8E, 0xB8C4A197, 0x8C786A4D, 0x63480154, 0xE501FDF9, 0x0A3196E0, 0x3E8D5D3A, 0xD1BD3623,
+    0x37F2D291, 0xD8C2B988, 0xEC7E7252, 0x034E194B, 0x8507E5E6, 0x6A378EFF, 0x5E8B4525, 0xB1BB2E3C
+  },
+  {
+    0x00000000, 0x68032CC8, 0xD0065990, 0xB8057558, 0xA5E0C5D1, 0xCDE3E919, 0x75E69C41, 0x1DE5B089,
+    0x4E2DFD53, 0x262ED19B, 0x9E2BA4C3, 0xF628880B, 0xEBCD3882, 0x83CE144A, 0x3BCB6112, 0x53C84DDA,
+    0x9C5BFAA6, 0xF458D66E, 0x4C5DA336, 0x245E8FFE, 0x39BB3F77, 0x51B813BF, 0xE9BD66E7, 0x81BE4A2F,
+    0xD27607F5, 0xBA752B3D, 0x02705E65, 0x6A7372AD, 0x7796C224, 0x1F95EEEC, 0xA7909BB4, 0xCF93B77C,
+    0x3D5B83BD, 0x5558AF75, 0xED5DDA2D, 0x855EF6E5, 0x98BB466C, 0xF0B86AA4, 0x48BD1FFC, 0x20BE3334,
+    0x73767EEE, 0x1B755226, 0xA370277E, 0xCB730BB6, 0xD696BB3F, 0xBE9597F7, 0x0690E2AF, 0x6E93CE67,
+    0xA100791B, 0xC90355D3, 0x7106208B, 0x19050C43, 0x04E0BCCA, 0x6CE39002, 0xD4E6E55A, 0xBCE5C992,
+    0xEF2D8448, 0x872EA880, 0x3F2BDDD8, 0x5728F110, 0x4ACD4199, 0x22CE6D51, 0x9ACB1809, 0xF2C834C1,
+    0x7AB7077A, 0x12B42BB2, 0xAAB15EEA, 0xC2B27222, 0xDF57C2AB, 0xB754EE63, 0x0F519B3B, 0x6752B7F3,
+    0x349AFA29, 0x5C99D6E1, 0xE49CA3B9, 0x8C9F8F71, 0x917A3FF8, 0xF9791330, 0x417C6668, 0x297F4AA0,
+    0xE6ECFDDC, 0x8EEFD114, 0x36EAA44C, 0x5EE98884, 0x430C380D, 0x2B0F14C5, 0x930A619D, 0xFB094D55,
+    0xA8C1008F, 0xC0C22C47, 0x78C7591F, 0x10C475D7, 0x0D21C55E, 0x6522E996, 0xDD279CCE, 0xB524B006,
+    0x47EC84C7, 0x2FEFA80F, 0x97EADD57, 0xFFE9F19F, 0xE20C4116, 0x8A0F6DDE, 0x320A1886, 0x5A09344E,
+    0x09C17994, 0x61C2555C, 0xD9C72004, 0xB1C40CCC, 0xAC21BC45, 0xC422908D, 0x7C27E5D5, 0x1424C91D,
+    0xDBB77E61, 0xB3B452A9, 0x0BB127F1, 0x63B20B39, 0x7E57BBB0, 0x16549778, 0xAE51E220, 0xC652CEE8,
+    0x959A8332, 0xFD99AFFA, 0x459CDAA2, 0x2D9FF66A, 0x307A46E3, 0x58796A2B, 0xE07C1F73, 0x887F33BB,
+    0xF56E0EF4, 0x9D6D223C, 0x25685764, 0x4D6B7BAC, 0x508ECB25, 0x388DE7ED, 0x808892B5, 0xE88BBE7D,
+    0xBB43F3A7, 0xD340DF6F, 0x6B45AA37, 0x034686FF, 0x1EA33676, 0x76A01ABE, 0xCEA56FE6, 0xA6A6432E,
+    0x6935F452, 0x0136D89A, 0xB933ADC2, 0xD130810A, 0xCCD53183, 0xA4D61D4B, 0x1CD36813, 0x74D044DB,
+    0x27180901, 0x4F1B25C9, 0xF71E5091, 0x9F1D7C59, 0x82F8CCD0, 0xEAFBE018, 0x52FE9540, 0x3AFDB988,
+    0xC8358D49, 0xA036A181, 0x1833D4D9, 0x7030F811, 0x6DD54898, 0x05D66450, 0xBDD31108, 0xD5D03DC0,
+    0x8618701A, 0xEE1B5CD2, 0x561E298A, 0x3E1D0542, 0x23F8B5CB, 0x4BFB9903, 0xF3FEEC5B, 0x9BFDC093,
+    0x546E77EF, 0x3C6D5B27, 0x84682E7F, 0xEC6B02B7, 0xF18EB23E, 0x998D9EF6, 0x2188EBAE, 0x498BC766,
+    0x1A438ABC, 0x7240A674, 0xCA45D32C, 0xA246FFE4, 0xBFA34F6D, 0xD7A063A5, 0x6FA516FD, 0x07A63A35,
+    0x8FD9098E, 0xE7DA2546, 0x5FDF501E, 0x37DC7CD6, 0x2A39CC5F, 0x423AE097, 0xFA3F95CF, 0x923CB907,
+    0xC1F4F4DD, 0xA9F7D815, 0x11F2AD4D, 0x79F18185, 0x6414310C, 0x0C171DC4, 0xB412689C, 0xDC114454,
+    0x1382F328, 0x7B81DFE0, 0xC384AAB8, 0xAB878670, 0xB66236F9, 0xDE611A31, 0x66646F69, 0x0E6743A1,
+    0x5DAF0E7B, 0x35AC22B3, 0x8DA957EB, 0xE5AA7B23, 0xF84FCBAA, 0x904CE762, 0x2849923A, 0x404ABEF2,
+    0xB2828A33, 0xDA81A6FB, 0x6284D3A3, 0x0A87FF6B, 0x17624FE2, 0x7F61632A, 0xC7641672, 0xAF673ABA,
+    0xFCAF7760, 0x94AC5BA8, 0x2CA92EF0, 0x44AA0238, 0x594FB2B1, 0x314C9E79, 0x8949EB21, 0xE14AC7E9,
+    0x2ED97095, 0x46DA5C5D, 0xFEDF2905, 0x96DC05CD, 0x8B39B544, 0xE33A998C, 0x5B3FECD4, 0x333CC01C,
+    0x60F48DC6, 0x08F7A10E, 0xB0F2D456, 0xD8F1F89E, 0xC5144817, 0xAD1764DF, 0x15121187, 0x7D113D4F
+  },
+  {
+    0x00000000, 0x493C7D27, 0x9278FA4E, 0xDB448769, 0x211D826D, 0x6821FF4A, 0xB3657823, 0xFA590504,
+    0x423B04DA, 0x0B0779FD, 0xD043FE94, 0x997F83B3, 0x632686B7, 0x2A1AFB90, 0xF15E7CF9, 0xB86201DE,
+    0x847609B4, 0xCD4A7493, 0x160EF3FA, 0x5F328EDD, 0xA56B8BD9, 0xEC57F6FE, 0x37137197, 0x7E2F0CB0,
+    0xC64D0D6E, 0x8F717049, 0x5435F720, 0x1D098A07, 0xE7508F03, 0xAE6CF224, 0x7528754D, 0x3C14086A,
+    0x0D006599, 0x443C18BE, 0x9F789FD7, 0xD644E2F0, 0x2C1DE7F4, 0x65219AD3, 0xBE651DBA, 0xF759609D,
+    0x4F3B6143, 0x06071C64, 0xDD439B0D, 0x947FE62A, 0x6E26E32E, 0x271A9E09, 0xFC5E1960, 0xB5626447,
+    0x89766C2D, 0xC04A110A, 0x1B0E9663, 0x5232EB44, 0xA86BEE40, 0xE1579367, 0x3A13140E, 0x732F6929,
+    0xCB4D68F7, 0x827115D0, 0x593592B9, 0x1009EF9E, 0xEA50EA9A, 0xA36C97BD, 0x782810D4, 0x31146DF3,
+    0x1A00CB32, 0x533CB615, 0x8878317C, 0xC1444C5B, 0x3B1D495F, 0x72213478, 0xA965B311, 0xE059CE36,
+    0x583BCFE8, 0x1107B2CF, 0xCA4335A6, 0x837F4881, 0x79264D85, 0x301A30A2, 0xEB5EB7CB, 0xA262CAEC,
+    0x9E76C286, 0xD74ABFA1, 0x0C0E38C8, 0x453245EF, 0xBF6B40EB, 0xF6573DCC, 0x2D13BAA5, 0x642FC782,
+    0xDC4DC65C, 0x9571BB7B, 0x4E353C12, 0x07094135, 0xFD504431, 0xB46C3916, 0x6F28BE7F, 0x2614C358,
+    0x1700AEAB, 0x5E3CD38C, 0x857854E5, 0xCC4429C2, 0x361D2CC6, 0x7F2151E1, 0xA465D688, 0xED59ABAF,
+    0x553BAA71, 0x1C07D756, 0xC743503F, 0x8E7F2D18, 0x7426281C, 0x3D1A553B, 0xE65ED252, 0xAF62AF75,
+    0x9376A71F, 0xDA4ADA38, 0x010E5D51, 0x48322076, 0xB26B2572, 0xFB575855, 0x2013DF3C, 0x692FA21B,
+    0xD14DA3C5, 0x9871DEE2, 0x4335598B, 0x0A0924AC, 0xF05021A8, 0xB96C5C8F, 0x6228DBE6, 0x2B14A6C1,
+    0x34019664, 0x7D3DEB43, 0xA6796C2A, 0xEF45110D, 0x151C1409, 0x5C20692E, 0x8764EE47, 0xCE589360,
+    0x763A92BE, 0x3F06EF99, 0xE44268F0, 0xAD7E15D7, 0x572710D3, 0x1E1B6DF4, 0xC55FEA9D, 0x8C6397BA,
+    0xB0779FD0, 0xF94BE2F7, 0x220F659E, 0x6B3318B9, 0x916A1DBD, 0xD856609A, 0x0312E7F3, 0x4A2E9AD4,
+    0xF24C9B0A, 0xBB70E62D, 0x60346144, 0x29081C63, 0xD3511967, 0x9A6D6440, 0x4129E329, 0x08159E0E,
+    0x3901F3FD, 0x703D8EDA, 0xAB7909B3, 0xE2457494, 0x181C7190, 0x51200CB7, 0x8A648BDE, 0xC358F6F9,
+    0x7B3AF727, 0x32068A00, 0xE9420D69, 0xA07E704E, 0x5A27754A, 0x131B086D, 0xC85F8F04, 0x8163F223,
+    0xBD77FA49, 0xF44B876E, 0x2F0F0007, 0x66337D20, 0x9C6A7824, 0xD5560503, 0x0E12826A, 0x472EFF4D,
+    0xFF4CFE93, 0xB67083B4, 0x6D3404DD, 0x240879FA, 0xDE517CFE, 0x976D01D9, 0x4C2986B0, 0x0515FB97,
+    0x2E015D56, 0x673D2071, 0xBC79A718, 0xF545DA3F, 0x0F1CDF3B, 0x4620A21C, 0x9D642575, 0xD4585852,
+    0x6C3A598C, 0x250624AB, 0xFE42A3C2, 0xB77EDEE5, 0x4D27DBE1, 0x041BA6C6, 0xDF5F21AF, 0x96635C88,
+    0xAA7754E2, 0xE34B29C5, 0x380FAEAC, 0x7133D38B, 0x8B6AD68F, 0xC256ABA8, 0x19122CC1, 0x502E51E6,
+    0xE84C5038, 0xA1702D1F, 0x7A34AA76, 0x3308D751, 0xC951D255, 0x806DAF72, 0x5B29281B, 0x1215553C,
+    0x230138CF, 0x6A3D45E8, 0xB179C281, 0xF845BFA6, 0x021CBAA2, 0x4B20C785, 0x906440EC, 0xD9583DCB,
+    0x613A3C15, 0x28064132, 0xF342C65B, 0xBA7EBB7C, 0x4027BE78, 0x091BC35F, 0xD25F4436, 0x9B633911,
+    0xA777317B, 0xEE4B4C5C, 0x350FCB35, 0x7C33B612, 0x866AB316, 0xCF56CE31, 0x14124958, 0x5D2E347F,
+    0xE54C35A1, 0xAC704886, 0x7734CFEF, 0x3E08B2C8, 0xC451B7CC, 0x8D6DCAEB, 0x56294D82, 0x1F1530A5
+  }
+};
+#endif
+
+#if defined(SIMD_SSE42) && defined(SIMD_PCLMUL) && defined(ARCH_X64)
+/* Blocks hashed as three interleaved streams, with the constants x^(16 * block - 33) and x^(8 * block - 33) mod P. */
+static const struct { UZ block; U32 shift2, shift1; } STR_CRC32C_STREAMS[] =
+{
+  { 2048, 0x82F89C77, 0xA51B6135 },
+  { 128, 0xB9E02B86, 0x0D3B6092 },
+};
+
+/* Advances a raw crc over as many zero bytes as the constant was made for. */
+static inline U32 STR_CRC32CShift(U32 crc, U32 constant)
+{
+  __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)crc), _mm_cvtsi32_si128((int)constant), 0);
+  return (U32)_mm_crc32_u64(0, (U64)_mm_cvtsi128_si64(product));
+}
+#endif
+
+U32 STR_CRC32CUpdate(U32 crc, STR data)
+{
+  const U8 *in = data.str;
+  UZ size = data.size;
+  crc = ~crc;
+#if defined(SIMD_SSE42)
+  for (; size && ((UP)in & 7); --size) crc = _mm_crc32_u8(crc, *in++);
+# if defined(SIMD_PCLMUL) && defined(ARCH_X64)
+  /* the crc32 instruction has a latency of three cycles, so large buffers run three streams and fold them together */
+  for (UZ s = 0; s < ArrayLength(STR_CRC32C_STREAMS); ++s)
+  {
+    UZ block = STR_CRC32C_STREAMS[s].block;
+    for (; size >= 3 * block; size -= 3 * block, in += 3 * block)
+    {
+      U64 a = crc, b = 0, c = 0;
+      for (UZ i = 0; i < block; i += 8)
+      {
+        a = _mm_crc32_u64(a, STR_Load64(in + i));
+        b = _mm_crc32_u64(b, STR_Load64(in + block + i));
+        c = _mm_crc32_u64(c, STR_Load64(in + 2 * block + i));
+      }
+      crc = STR_CRC32CShift((U32)a, STR_CRC32C_STREAMS[s].shift2) ^ STR_CRC32CShift((U32)b, STR_CRC32C_STREAMS[s].shift1) ^ (U32)c;
+    }
+  }
+# endif
+# if defined(ARCH_X64)
+  for (; size >= 8; size -= 8, in += 8) crc = (U32)_mm_crc32_u64(crc, STR_Load64(in));
+# endif
+  for (; size >= 4; size -= 4, in += 4) crc = _mm_crc32_u32(crc, STR_Load32(in));
+  for (; size; --size) crc = _mm_crc32_u8(crc, *in++);
+#elif defined(SIMD_ARM_CRC32)
+  for (; size && ((UP)in & 7); --size) crc = __crc32cb(crc, *in++);
+  for (; size >= 8; size -= 8, in += 8) crc = __crc32cd(crc, STR_Load64(in));
+  for (; size; --size) crc = __crc32cb(crc, *in++);
+#else
+  /* slicing by eight: one table per byte position of a 64-bit word */
+  for (; size >= 8; size -= 8, in += 8)
+  {
+    U64 word = STR_Load64(in) ^ crc;
+    crc = STR_CRC32C_TABLE[7][word & 0xFF] ^ STR_CRC32C_TABLE[6][(word >> 8) & 0xFF]
+      ^ STR_CRC32C_TABLE[5][(word >> 16) & 0xFF] ^ STR_CRC32C_TABLE[4][(word >> 24) & 0xFF]
+      ^ STR_CRC32C_TABLE[3][(word >> 32) & 0xFF] ^ STR_CRC32C_TABLE[2][(word >> 40) & 0xFF]
+      ^ STR_CRC32C_TABLE[1][(word >> 48) & 0xFF] ^ STR_CRC32C_TABLE[0][word >> 56];
+  }
+  for (; size; --size) crc = (crc >> 8) ^ STR_CRC32C_TABLE[0][(crc ^ *in++) & 0xFF];
+#endif
+  return ~crc;
+}
+
+U32 STR_CRC32C(STR data)
+{
+  return STR_CRC32CUpdate(0, data);
+}
+
+#define STR_ADLER32_MOD   65521
+#define STR_ADLER32_NMAX  5552
+
+U32 STR_Adler32Update(U32 adler, STR data)
+{
+  U32 a = adler & 0xFFFF, b = adler >> 16;
+  const U8 *in = data.str;
+  /* the sums cannot overflow 32 bits within STR_ADLER32_NMAX bytes, so reduce once per block */
+  for (UZ size = data.size, block; size; size -= block)
+  {
+    block = Min(size, (UZ)STR_ADLER32_NMAX);
+    const U8 *end = in + block;
+    for (; in + 8 <= end; in += 8)
+    {
+      a += in[0]; b += a;
+      a += in[1]; b += a;
+      a += in[2]; b += a;
+      a += in[3]; b += a;
+      a += in[4]; b += a;
+      a += in[5]; b += a;
+      a += in[6]; b += a;
+      a += in[7]; b += a;
+    }
+    for (; in < end; ++in)
+    {
+      a += *in;
+      b += a;
+    }
+    a %= STR_ADLER32_MOD;
+    b %= STR_ADLER32_MOD;
+  }
+  return b << 16 | a;
+}
+
+U32 STR_Adler32(STR data)
+{
+  return STR_Adler32Update(1, data);
+}
+
+#define STR_XXH64_PRIME1 0x9E3779B185EBCA87ULL
+#define STR_XXH64_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define STR_XXH64_PRIME3 0x165667B19E3779F9ULL
+#define STR_XXH64_PRIME4 0x85EBCA77C2B2AE63ULL
+#define STR_XXH64_PRIME5 0x27D4EB2F165667C5ULL
+
+#define STR_RotateLeft64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static inline U64 STR_XXH64Round(U64 accumulator, U64 input)
+{
+  accumulator += input * STR_XXH64_PRIME2;
+  accumulator = STR_RotateLeft64(accumulator, 31);
+  return accumulator * STR_XXH64_PRIME1;
+}
+
+static inline U64 STR_XXH64Merge(U64 hash, U64 accumulator)
+{
+  hash ^= STR_XXH64Round(0, accumulator);
+  return hash * STR_XXH64_PRIME1 + STR_XXH64_PRIME4;
+}
+
+STR_XXH64State STR_XXH64Init(U64 seed)
+{
+  STR_XXH64State state = { 0 };
+  state.accumulators[0] = seed + STR_XXH64_PRIME1 + STR_XXH64_PRIME2;
+  state.accumulators[1] = seed + STR_XXH64_PRIME2;
+  state.accumulators[2] = seed;
+  state.accumulators[3] = seed - STR_XXH64_PRIME1;
+  state.seed = seed;
+  return state;
+}
+
+static void STR_XXH64Stripes(U64 *accumulators, const U8 *in, UZ size)
+{
+  U64 a = accumulators[0], b = accumulators[1], c = accumulators[2], d = accumulators[3];
+  for (const U8 *end = in + size; in < end; in += 32)
+  {
+    a = STR_XXH64Round(a, STR_Load64(in));
+    b = STR_XXH64Round(b, STR_Load64(in + 8));
+    c = STR_XXH64Round(c, STR_Load64(in + 16));
+    d = STR_XXH64Round(d, STR_Load64(in + 24));
+  }
+  accumulators[0] = a;
+  accumulators[1] = b;
+  accumulators[2] = c;
+  accumulators[3] = d;
+}
+
+void STR_XXH64Update(STR_XXH64State *state, STR data)
+{
+  const U8 *in = data.str;
+  UZ size = data.size, buffered = (UZ)(state->size & 31);
+  state->size += size;
+  if (buffered)
+  {
+    UZ fill = Min(size, 32 - buffered);
+    MemoryCopy(state->buffer + buffered, in, fill);
+    in += fill;
+    size -= fill;
+    if (buffered + fill < 32) return;
+    STR_XXH64Stripes(state->accumulators, state->buffer, 32);
+  }
+  STR_XXH64Stripes(state->accumulators, in, size & ~(UZ)31);
+  MemoryCopy(state->buffer, in + (size & ~(UZ)31), size & 31);
+}
+
+U64 STR_XXH64Digest(const STR_XXH64State *state)
+{
+  U64 hash;
+  if (state->size >= 32)
+  {
+    const U64 *v = state->accumulators;
+    hash = STR_RotateLeft64(v[0], 1) + STR_RotateLeft64(v[1], 7) + STR_RotateLeft64(v[2], 12) + STR_RotateLeft64(v[3], 18);
+    for (U32 i = 0; i < 4; ++i) hash = STR_XXH64Merge(hash, v[i]);
+  }
+  else
+  {
+    hash = state->seed + STR_XXH64_PRIME5;
+  }
+  hash += state->size;
+  const U8 *in = state->buffer, *end = in + (state->size & 31);
+  for (; in + 8 <= end; in += 8)
+  {
+    hash ^= STR_XXH64Round(0, STR_Load64(in));
+    hash = STR_RotateLeft64(hash, 27) * STR_XXH64_PRIME1 + STR_XXH64_PRIME4;
+  }
+  if (in + 4 <= end)
+  {
+    hash ^= (U64)STR_Load32(in) * STR_XXH64_PRIME1;
+    hash = STR_RotateLeft64(hash, 23) * STR_XXH64_PRIME2 + STR_XXH64_PRIME3;
+    in += 4;
+  }
+  for (; in < end; ++in)
+  {
+    hash ^= *in * STR_XXH64_PRIME5;
+    hash = STR_RotateLeft64(hash, 11) * STR_XXH64_PRIME1;
+  }
+  hash ^= hash >> 33;
+  hash *= STR_XXH64_PRIME2;
+  hash ^= hash >> 29;
+  hash *= STR_XXH64_PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+U64 STR_XXH64(STR data, U64 seed)
+{
+  STR_XXH64State state = STR_XXH64Init(seed);
+  STR_XXH64Update(&state, data);
+  return STR_XXH64Digest(&state);
+}
+
+/* Parses a decimal field of a placeholder, returning false if it overflows. */
+static bool STR_FormatParseNumber(STR format, UZ *offset, U32 *value)
+{
+  U64 number = 0;
+  for (; *offset < format.size && STR_IsDigit(format.str[*offset]); ++*offset)
+  {
+    number = number * 10 + (format.str[*offset] - '0');
+    if (number > STR_FORMAT_MAX_PRECISION * 16) return false;
+  }
+  *value = (U32)number;
+  return true;
+}
+
+static bool STR_FormatIsAlign(U8 c)
+{
+  return c == '<' || c == '>' || c == '^';
+}
+
+/* Parses the literal text up to the next placeholder and the placeholder itself, returning false if it is malformed. */
+static bool STR_FormatParse(STR format, UZ *offset, U32 *next, STR_FormatPiece *piece)
+{
+  UZ i = *offset;
+  *piece = (STR_FormatPiece) { .literal = { format.str + i }, .arg = STR_FORMAT_NO_ARG, .precision = STR_PRECISION_SHORTEST, .fill = ' ' };
+  for (; i < format.size && format.str[i] != '{' && format.str[i] != '}'; ++i);
+  piece->literal.size = i - *offset;
+  if (i == format.size)
+  {
+    *offset = i;
+    return true;
+  }
+  /* a doubled brace ends the literal with one of them */
+  if (i + 1 < format.size && format.str[i + 1] == format.str[i])
+  {
+    piece->literal.size++;
+    *offset = i + 2;
+    return true;
+  }
+  if (format.str[i++] == '}') return false;
+  if (i < format.size && STR_IsDigit(format.str[i]))
+  {
+    if (!STR_FormatParseNumber(format, &i, &piece->arg)) return false;
+  }
+  else
+  {
+    piece->arg = (*next)++;
+  }
+  if (i < format.size && format.str[i] == ':')
+  {
+    ++i;
+    if (i + 1 < format.size && STR_FormatIsAlign(format.str[i + 1]))
+    {
+      piece->fill = format.str[i];
+      piece->align = format.str[i + 1];
+      i += 2;
+    }
+    else if (i < format.size && STR_FormatIsAlign(format.str[i]))
+    {
+      piece->align = format.str[i++];
+    }
+    if (i < format.size && format.str[i] == '0')
+    {
+      piece->zero = true;
+      ++i;
+    }
+    if (!STR_FormatParseNumber(format, &i, &piece->width)) return false;
+    if (i < format.size && format.str[i] == '.')
+    {
+      ++i;
+      if (i == format.size || !STR_IsDigit(format.str[i])) return false;
+      if (!STR_FormatParseNumber(format, &i, &piece->precision) || piece->precision > STR_FORMAT_MAX_PRECISION) return false;
+    }
+    if (i < format.size && (format.str[i] == 'x' || format.str[i] == 'X' || format.str[i] == 'b' || format.str[i] == 'f'))
+    {
+      piece->type = format.str[i++];
+    }
+  }
+  if (i == format.size || format.str[i] != '}') return false;
+  *offset = i + 1;
+  return true;
+}
+
+STR_Format STR_FormatCompile(MEM *mem, STR format)
+{
+  STR_Format result = { 0 };
+  STR_FormatPiece piece;
+  UZ count = 0;
+  U32 next = 0;
+  for (UZ offset = 0; offset < format.size; ++count)
+  {
+    if (!STR_FormatParse(format, &offset, &next, &piece) || count == MAX_U32) return result;
+  }
+  STR_FormatPiece *pieces = MEM_AllocateArrayTyped(mem, Max(count, (UZ)1), STR_FormatPiece);
+  if (!pieces) return result;
+  next = 0;
+  for (UZ offset = 0, i = 0; offset < format.size; ++i)
+  {
+    STR_FormatParse(format, &offset, &next, pieces + i);
+    if (pieces[i].arg != STR_FORMAT_NO_ARG) result.args = Max(result.args, pieces[i].arg + 1);
+  }
+  result.pieces = pieces;
+  result.count = (U32)count;
+  return result;
+}
+
+void STR_FormatFree(MEM *mem, STR_Format *format)
+{
+  if (format->pieces) MEM_Deallocate(mem, format->pieces);
+  MemoryZeroStruct(format);
+}
+
+/* Writes an integer in a power of two radix. */
+static UZ STR_FormatRadix(U8 *buffer, U64 value, U32 shift, const U8 *digits)
+{
+  UZ size = (64 - CountLeadingZeros64(value | 1) + shift - 1) / shift;
+  for (UZ i = size; i--; value >>= shift) buffer[i] = digits[value & ((1u << shift) - 1)];
+  return size;
+}
+
+/* Formats an argument before padding, pointing data either at the buffer or at the string argument. */
+static UZ STR_FormatArg(U8 *buffer, UZ capacity, const STR_FormatPiece *piece, const STR_Arg *arg, const U8 **data)
+{
+  static const U8 STR_FORMAT_UPPER_HEX[17] = "0123456789ABCDEF";
+  *data = buffer;
+  switch (arg->type)
+  {
+    case STR_ARG_STR:
+    {
+      /* the precision counts codepoints like the width, so the cut is at the start of the next one */
+      STR string = arg->value.s;
+      UZ size = string.size;
+      if (piece->precision < size)
+      {
+        for (UZ count = 0, i = 0; i < string.size; ++i)
+        {
+          if ((string.str[i] & 0xC0) != 0x80 && count++ == piece->precision) { size = i; break; }
+        }
+      }
+      *data = string.str;
+      return size;
+    }
+    case STR_ARG_U64:
+    case STR_ARG_S64:
+      if (piece->type == 'x') return STR_FormatRadix(buffer, arg->value.u, 4, STR_HEX_DIGITS);
+      if (piece->type == 'X') return STR_FormatRadix(buffer, arg->value.u, 4, STR_FORMAT_UPPER_HEX);
+      if (piece->type == 'b') return STR_FormatRadix(buffer, arg->value.u, 1, STR_HEX_DIGITS);
+      if (arg->type == STR_ARG_S64) return STR_FormatS64(buffer, capacity, arg->value.i);
+      return STR_FormatU64(buffer, capacity, arg->value.u);
+    case STR_ARG_F64:
+      if (piece->precision == STR_PRECISION_SHORTEST && piece->type != 'f') return STR_FormatF64(buffer, capacity, arg->value.f);
+      return STR_FormatF64Fixed(buffer, capacity, arg->value.f, piece->precision == STR_PRECISION_SHORTEST ? 6 : piece->precision);
+  }
+  return 0;
+}
+
+/* Output of a format: a builder, a buffer, or neither to only measure. */
+typedef struct STR_FormatOutput
+{
+  STR_Builder *builder;
+  U8 *buffer;
+  UZ capacity;
+  UZ size;
+  bool failed;
+} STR_FormatOutput;
+
+static void STR_FormatEmit(STR_FormatOutput *output, const U8 *data, UZ size)
+{
+  if (output->builder)
+  {
+    if (!STR_BuilderAppend(output->builder, (STR) { (U8*)data, size })) output->failed = true;
+  }
+  else if (output->buffer)
+  {
+    if (size > output->capacity - output->size) output->failed = true;
+    else MemoryCopy(output->buffer + output->size, data, size);
+  }
+  output->size += size;
+}
+
+static void STR_FormatEmitFill(STR_FormatOutput *output, U8 fill, UZ count)
+{
+  U8 run[32];
+  memset(run, fill, Min(count, sizeof(run)));
+  for (UZ size; count && !output->failed; count -= size)
+  {
+    size = Min(count, sizeof(run));
+    STR_FormatEmit(output, run, size);
+  }
+}
+
+static bool STR_FormatRun(STR_FormatOutput *output, const STR_Format *format, const STR_Arg *args, UZ count)
+{
+  /* large enough for a fixed float with the maximum precision */
+  U8 buffer[DBL_MAX_10_EXP + STR_FORMAT_MAX_PRECISION + 8];
+  if (format->args > count) return false;
+  for (U32 p = 0; p < format->count && !output->failed; ++p)
+  {
+    const STR_FormatPiece *piece = format->pieces + p;
+    if (piece->literal.size) STR_FormatEmit(output, piece->literal.str, piece->literal.size);
+    if (piece->arg == STR_FORMAT_NO_ARG) continue;
+    const STR_Arg *arg = args + piece->arg;
+    const U8 *data;
+    UZ size = STR_FormatArg(buffer, sizeof(buffer), piece, arg, &data);
+    if (!piece->width)
+    {
+      STR_FormatEmit(output, data, size);
+      continue;
+    }
+    UZ length = arg->type == STR_ARG_STR ? UTF8_CountCodepoints((STR) { (U8*)data, size }) : size;
+    UZ padding = piece->width > length ? piece->width - length : 0, before = 0;
+    if (piece->zero && !piece->align && arg->type != STR_ARG_STR)
+    {
+      /* zeros go between the sign and the digits */
+      UZ sign = size && (data[0] == '-' || data[0] == '+');
+      STR_FormatEmit(output, data, sign);
+      STR_FormatEmitFill(output, '0', padding);
+      STR_FormatEmit(output, data + sign, size - sign);
+      continue;
+    }
+    U8 align = piece->align ? piece->align : arg->type == STR_ARG_STR ? '<' : '>';
+    if (align == '>') before = padding;
+    else if (align == '^') before = padding / 2;
+    STR_FormatEmitFill(output, piece->fill, before);
+    STR_FormatEmit(output, data, size);
+    STR_FormatEmitFill(output, piece->fill, padding - before);
+  }
+  return !output->failed;
+}
+
+UZ STR_FormatSize(const STR_Format *format, const STR_Arg *args, UZ count)
+{
+  STR_FormatOutput output = { 0 };
+  return STR_FormatRun(&output, format, args, count) ? output.size : 0;
+}
+
+UZ STR_FormatWrite(U8 *buffer, UZ capacity, const STR_Format *format, const STR_Arg *args, UZ count)
+{
+  STR_FormatOutput output = { .buffer = buffer, .capacity = capacity };
+  return STR_FormatRun(&output, format, args, count) ? output.size : 0;
+}
+
+STR STR_From_Format(MEM *mem, const STR_Format *format, const STR_Arg *args, UZ count)
+{
+  if (format->args > count) return (STR) { 0 };
+  STR result = STR_Allocate(mem, STR_FormatSize(format, args, count));
+  if (result.str) STR_FormatWrite(result.str, result.size, format, args, count);
+  return result;
+}
+
+void STR_BuilderFree(STR_Builder *builder)
+{
+  for (STR_BuilderChunk *chunk = builder->first, *next; chunk; chunk = next)
+  {
+    next = chunk->next;
+    MEM_Deallocate(builder->mem, chunk);
+  }
+  builder->first = nullptr;
+  builder->last = nullptr;
+  builder->size = 0;
+  builder->count = 0;
+}
+
+U8 *STR_BuilderReserve(STR_Builder *builder, UZ size)
+{
+  STR_BuilderChunk *last = builder->last;
+  if (!last || last->capacity - last->size < size)
+  {
+    UZ capacity = last ? Min(last->capacity << 1, (UZ)STR_BUILDER_MAX_CHUNK_SIZE) : (UZ)STR_BUILDER_CHUNK_SIZE;
+    capacity = Max(capacity, size);
+    STR_BuilderChunk *chunk = MEM_Allocate(builder->mem, sizeof(STR_BuilderChunk) + capacity);
+    if (!chunk) return nullptr;
+    chunk->next = nullptr;
+    chunk->size = 0;
+    chunk->capacity = capacity;
+    if (last) last->next = chunk;
+    else builder->first = chunk;
+    builder->last = last = chunk;
+    ++builder->count;
+  }
+  return STR_BuilderChunkData(last) + last->size;
+}
+
+void STR_BuilderCommit(STR_Builder *builder, UZ size)
+{
+  if (builder->last)
+  {
+    size = Min(size, builder->last->capacity - builder->last->size);
+    builder->last->size += size;
+    builder->size += size;
+  }
+}
+
+bool STR_BuilderAppend(STR_Builder *builder, STR string)
+{
+  STR_BuilderChunk *last = builder->last;
+  if (last && last->size < last->capacity)
+  {
+    UZ size = Min(string.size, last->capacity - last->size);
+    MemoryCopy(STR_BuilderChunkData(last) + last->size, string.str, size);
+    STR_BuilderCommit(builder, size);
+    string.str += size;
+    string.size -= size;
+  }
+  if (string.size)
+  {
+    U8 *data = STR_BuilderReserve(builder, string.size);
+    if (!data) return false;
+    MemoryCopy(data, string.str, string.size);
+    STR_BuilderCommit(builder, string.size);
+  }
+  return true;
+}
+
+bool STR_BuilderAppendByte(STR_Builder *builder, U8 byte)
+{
+  U8 *data = STR_BuilderReserve(builder, 1);
+  if (!data) return false;
+  *data = byte;
+  STR_BuilderCommit(builder, 1);
+  return true;
+}
+
+bool STR_BuilderAppendU64(STR_Builder *builder, U64 value)
+{
+  U8 *buffer = STR_BuilderReserve(builder, STR_U64_MAX_SIZE);
+  if (!buffer) return false;
+  STR_BuilderCommit(builder, STR_FormatU64(buffer, STR_U64_MAX_SIZE, value));
+  return true;
+}
+
+bool STR_BuilderAppendS64(STR_Builder *builder, S64 value)
+{
+  U8 *buffer = STR_BuilderReserve(builder, STR_S64_MAX_SIZE);
+  if (!buffer) return false;
+  STR_BuilderCommit(builder, STR_FormatS64(buffer, STR_S64_MAX_SIZE, value));
+  return true;
+}
+
+bool STR_BuilderAppendF64(STR_Builder *builder, F64 value, U32 precision)
+{
+  if (precision == STR_PRECISION_SHORTEST)
+  {
+    U8 *buffer = STR_BuilderReserve(builder, STR_F64_MAX_SIZE);
+    if (!buffer) return false;
+    STR_BuilderCommit(builder, STR_FormatF64(buffer, STR_F64_MAX_SIZE, value));
+    return true;
+  }
+  U8 special[4];
+  U64 bits;
+  MemoryCopy(&bits, &value, sizeof(bits));
+  UZ size = STR_WriteSpecial(special, bits, &STR_FORMAT_F64);
+  if (size) return STR_BuilderAppend(builder, (STR) { special, size });
+  STR_Decimal decimal;
+  size = STR_FixedDecimal(&decimal, bits, precision);
+  U8 *buffer = STR_BuilderReserve(builder, size);
+  if (!buffer) return false;
+  STR_WriteFixed(buffer, &decimal, bits, precision);
+  STR_BuilderCommit(builder, size);
+  return true;
+}
+
+bool STR_BuilderAppendBase64(STR_Builder *builder, STR data, STR_Base64 alphabet)
+{
+  UZ size = STR_Base64EncodedSize(data.size, alphabet);
+  U8 *buffer = STR_BuilderReserve(builder, size);
+  if (!buffer) return false;
+  STR_BuilderCommit(builder, STR_Base64Encode(buffer, size, data, alphabet));
+  return true;
+}
+
+bool STR_BuilderAppendHex(STR_Builder *builder, STR data)
+{
+  U8 *buffer = STR_BuilderReserve(builder, data.size * 2);
+  if (!buffer) return false;
+  STR_BuilderCommit(builder, STR_HexEncode(buffer, data.size * 2, data));
+  return true;
+}
+
+bool STR_BuilderAppendFormat(STR_Builder *builder, const STR_Format *format, const STR_Arg *args, UZ count)
+{
+  STR_FormatOutput output = { .builder = builder };
+  return STR_FormatRun(&output, format, args, count);
+}
+
+UZ STR_BuilderGetSlices(STR_Builder *builder, STR *slices, UZ capacity)
+{
+  UZ count = 0;
+  for (STR_BuilderChunk *chunk = builder->first; chunk && count < capacity; chunk = chunk->next)
+  {
+    slices[count].str = STR_BuilderChunkData(chunk);
+    slices[count++].size = chunk->size;
+  }
+  return count;
+}
+
+STR STR_From_Builder(MEM *mem, STR_Builder *builder)
+{
+  STR result = STR_Allocate(mem, builder->size);
+  if (result.str)
+  {
+    UZ size = 0;
+    for (STR_BuilderChunk *chunk = builder->first; chunk; chunk = chunk->next)
+    {
+      MemoryCopy(result.str + size, STR_BuilderChunkData(chunk), chunk->size);
+      size += chunk->size;
+    }
+  }
+  return result;
+}
+
+bool STR_BuilderAppendReplaceMany(STR_Builder *builder, STR string, const STR_ReplaceRule *rules, UZ count)
+{
+  STR_ByteSet first;
+  UZ from = 0;
+  STR_ReplaceInitFirst(&first, rules, count);
+  if (count == 1 && !rules[0].substring.size) count = 0;
+  for (UZ offset = 0, rule; count && (offset = STR_ReplaceFindNext(&first, rules, count, string, offset, &rule)) < string.size;)
+  {
+    if (!STR_BuilderAppend(builder, (STR) { string.str + from, offset - from })) return false;
+    if (!STR_BuilderAppend(builder, rules[rule].replacement)) return false;
+    from = offset += rules[rule].substring.size;
+  }
+  return STR_BuilderAppend(builder, (STR) { string.str + from, string.size - from });
+}
@@ -23,3 +23,316 @@ STR UTL_LoadFile(MEM *mem, STR path)
   }
   return result;
 }
+
+UZ UTL_WriteBuilder(OS_File file, STR_Builder *builder)
+{
+  STR slices[64];
+  UZ result = 0;
+  STR_BuilderChunk *chunk = builder->first;
+  while (chunk)
+  {
+    UZ count = 0, expected = 0;
+    for (; chunk && count < ArrayLength(slices); chunk = chunk->next, ++count)
+    {
+      slices[count] = (STR) { STR_BuilderChunkData(chunk), chunk->size };
+      expected += chunk->size;
+    }
+    UZ bytes = OS_FileWriteVector(file, slices, count);
+    result += bytes;
+    if (bytes < expected) break;
+  }
+  return result;
+}
+
+#define UTL_INTERN_MIN_CAPACITY 64
+
+static U64 UTL_InternHash(STR string)
+{
+  U64 hash = STR_Hash64(string) ^ string.size;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+UTL_InternTable UTL_InternTableInit(MEM *mem, MEM_Arena *arena)
+{
+  UTL_InternTable table = { .mem = mem, .arena = arena };
+  return table;
+}
+
+UTL_InternTable UTL_InternTableInitAtomic(MEM *mem, MEM_Arena *arena)
+{
+  UTL_InternTable table = { .mem = mem, .arena = arena };
+  table.mutex = OS_MutexInit();
+  return table;
+}
+
+void UTL_InternTableFree(UTL_InternTable *table)
+{
+  if (table->entries) MEM_Deallocate(table->mem, table->entries);
+  if (table->slots) MEM_Deallocate(table->mem, table->slots);
+  if (table->mutex) OS_MutexFree(table->mutex);
+  MemoryZeroStruct(table);
+}
+
+/* Returns the slot holding the string or the empty slot where it belongs. */
+static UTL_Atom *UTL_InternProbe(UTL_InternTable *table, STR string, U64 hash)
+{
+  U32 mask = table->capacity - 1;
+  for (U32 index = (U32)hash & mask;; index = (index + 1) & mask)
+  {
+    UTL_Atom *slot = table->slots + index;
+    if (!*slot) return slot;
+    UTL_InternEntry *entry = table->entries + *slot - 1;
+    if (entry->hash == hash && entry->string.size == string.size && !memcmp(entry->data, string.str, string.size)) return slot;
+  }
+}
+
+static bool UTL_InternGrow(UTL_InternTable *table)
+{
+  if (table->count + 1 > table->reserved)
+  {
+    U32 reserved = table->reserved ? table->reserved << 1 : UTL_INTERN_MIN_CAPACITY;
+    UTL_InternEntry *entries = MEM_Reallocate(table->mem, table->entries, sizeof(UTL_InternEntry) * reserved);
+    if (!entries) return false;
+    table->entries = entries;
+    table->reserved = reserved;
+  }
+  if ((table->count + 1) * 4 > table->capacity * 3)
+  {
+    U32 capacity = table->capacity ? table->capacity << 1 : UTL_INTERN_MIN_CAPACITY;
+    UTL_Atom *slots = MEM_AllocateArrayTyped(table->mem, capacity, UTL_Atom);
+    if (!slots) return false;
+    if (table->slots) MEM_Deallocate(table->mem, table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    for (U32 i = 0; i < table->count; ++i)
+    {
+      UTL_InternEntry *entry = table->entries + i;
+      *UTL_InternProbe(table, (STR) { entry->data, entry->string.size }, entry->hash) = i + 1;
+    }
+  }
+  return true;
+}
+
+static UTL_Atom UTL_InternLocked(UTL_InternTable *table, STR string, bool insert)
+{
+  U64 hash = UTL_InternHash(string);
+  if (string.size > MAX_U32) return UTL_ATOM_NULL;
+  if (table->count)
+  {
+    UTL_Atom *slot = UTL_InternProbe(table, string, hash);
+    if (*slot || !insert) return *slot;
+  }
+  else if (!insert) return UTL_ATOM_NULL;
+  if (table->count == MAX_U32 - 1 || !UTL_InternGrow(table)) return UTL_ATOM_NULL;
+  U8 *data = MEM_ArenaAllocate(table->arena, string.size + 1);
+  if (!data) return UTL_ATOM_NULL;
+  MemoryCopy(data, string.str, string.size);
+  data[string.size] = 0;
+  UTL_InternEntry *entry = table->entries + table->count;
+  entry->string = USTR_Init((STR) { data, string.size });
+  entry->data = data;
+  entry->hash = hash;
+  return *UTL_InternProbe(table, string, hash) = ++table->count;
+}
+
+UTL_Atom UTL_Intern(UTL_InternTable *table, STR string)
+{
+  UTL_Atom atom = UTL_ATOM_NULL;
+  if (!table->mutex) return UTL_InternLocked(table, string, true);
+  if (OS_MutexLock(table->mutex))
+  {
+    atom = UTL_InternLocked(table, string, true);
+    OS_MutexUnlock(table->mutex);
+  }
+  return atom;
+}
+
+UTL_Atom UTL_InternFind(UTL_InternTable *table, STR string)
+{
+  UTL_Atom atom = UTL_ATOM_NULL;
+  if (!table->mutex) return UTL_InternLocked(table, string, false);
+  if (OS_MutexLock(table->mutex))
+  {
+    atom = UTL_InternLocked(table, string, false);
+    OS_MutexUnlock(table->mutex);
+  }
+  return atom;
+}
+
+USTR UTL_InternUSTR(UTL_InternTable *table, STR string)
+{
+  return UTL_AtomToUSTR(table, UTL_Intern(table, string));
+}
+
+USTR UTL_AtomToUSTR(UTL_InternTable *table, UTL_Atom atom)
+{
+  USTR result = { 0 };
+  if (table->mutex && !OS_MutexLock(table->mutex)) return result;
+  if (atom && atom <= table->count) result = table->entries[atom - 1].string;
+  if (table->mutex) OS_MutexUnlock(table->mutex);
+  return result;
+}
+
+STR UTL_AtomToSTR(UTL_InternTable *table, UTL_Atom atom)
+{
+  STR result = { null };
+  if (table->mutex && !OS_MutexLock(table->mutex)) return result;
+  if (atom && atom <= table->count)
+  {
+    result.str = table->entries[atom - 1].data;
+    result.size = table->entries[atom - 1].string.size;
+  }
+  if (table->mutex) OS_MutexUnlock(table->mutex);
+  return result;
+}
+
+#define UTL_LINE_INDEX_MIN_CHUNK MiB(1)
+
+typedef struct UTL_LineIndexTask
+{
+  UTL_LineIndex *index;
+  STR text;
+  UZ offset;
+  UZ line;
+  UZ *segments;
+} UTL_LineIndexTask;
+
+static U32 OSAPI UTL_LineIndexCount(void *param)
+{
+  UTL_LineIndexTask *task = param;
+  task->line = STR_CountByte(task->text, '\n');
+  return 0;
+}
+
+/* Records the lines starting after the newlines of the task text, the first one of segment k in segments[k]. */
+static U32 OSAPI UTL_LineIndexFill(void *param)
+{
+  UTL_LineIndexTask *task = param;
+  STR_ByteSet newline = STR_ByteSetMake(STR_Static("\n"));
+  UZ line = task->line;
+  for (UZ i = 0; i < task->text.size; i += 64)
+  {
+    STR block = { task->text.str + i, task->text.size - i };
+    for (U64 mask = STR_ByteSetClassify(&newline, block); mask; mask &= mask - 1)
+    {
+      U64 start = (U64)task->offset + i + CountTrailingZeros64(mask) + 1;
+      task->index->starts[++line] = (U32)start;
+      if (task->segments[start >> 32] == MAX_UZ) task->segments[start >> 32] = line;
+    }
+  }
+  return 0;
+}
+
+/* Runs the function for every task, on new threads where possible and on the calling thread otherwise. */
+static void UTL_LineIndexRun(OS_ThreadFunc *function, UTL_LineIndexTask *tasks, OS_Thread *threads, U32 count)
+{
+  for (U32 i = 1; i < count; ++i)
+  {
+    threads[i] = OS_ThreadCreate(function, tasks + i);
+  }
+  function(tasks);
+  for (U32 i = 1; i < count; ++i)
+  {
+    if (threads[i]) OS_ThreadJoin(threads[i], null);
+    else function(tasks + i);
+  }
+}
+
+UTL_LineIndex UTL_LineIndexInit(MEM *mem, STR text, U32 threads)
+{
+  UTL_LineIndex index = { .mem = mem };
+  UTL_LineIndexTask tasks[64];
+  OS_Thread handles[ArrayLength(tasks)];
+  U32 count = (U32)Clamp(1, text.size / UTL_LINE_INDEX_MIN_CHUNK, Clamp(1, threads, ArrayLength(tasks)));
+  UZ chunk = text.size / count;
+  for (U32 i = 0; i < count; ++i)
+  {
+    UZ end = i + 1 < count ? chunk * (i + 1) : text.size;
+    tasks[i] = (UTL_LineIndexTask) { .index = &index, .text = { text.str + chunk * i, end - chunk * i }, .offset = chunk * i };
+  }
+  UTL_LineIndexRun(UTL_LineIndexCount, tasks, handles, count);
+
+  /* each task fills its lines after the ones counted by the previous tasks */
+  UZ lines = 0;
+  for (U32 i = 0; i < count; ++i)
+  {
+    UZ newlines = tasks[i].line;
+    tasks[i].line = lines;
+    lines += newlines;
+  }
+  index.count = lines + 1;
+  index.segment_count = (UZ)((U64)text.size >> 32) + 1;
+  index.starts = MEM_AllocateArrayTyped(mem, index.count, U32);
+  index.segments = MEM_AllocateArrayTyped(mem, index.segment_count * count, UZ);
+  if (!index.starts || !index.segments)
+  {
+    UTL_LineIndexFree(&index);
+    return index;
+  }
+  memset(index.segments, 0xFF, sizeof(UZ) * index.segment_count * count);
+  for (U32 i = 0; i < count; ++i)
+  {
+    tasks[i].segments = index.segments + index.segment_count * i;
+  }
+  index.starts[0] = 0;
+  UTL_LineIndexRun(UTL_LineIndexFill, tasks, handles, count);
+
+  /* tasks own ascending lines, so the first task to reach a segment has its first line */
+  for (UZ k = 0; k < index.segment_count; ++k)
+  {
+    for (U32 i = 1; i < count && index.segments[k] == MAX_UZ; ++i)
+    {
+      index.segments[k] = tasks[i].segments[k];
+    }
+  }
+  index.segments[0] = 0;
+  for (UZ k = index.segment_count - 1; k > 0; --k)
+  {
+    if (index.segments[k] == MAX_UZ) index.segments[k] = k + 1 < index.segment_count ? index.segments[k + 1] : index.count;
+  }
+  return index;
+}
+
+void UTL_LineIndexFree(UTL_LineIndex *index)
+{
+  if (index->starts) MEM_Deallocate(index->mem, index->starts);
+  if (index->segments) MEM_Deallocate(index->mem, index->segments);
+  MemoryZeroStruct(index);
+}
+
+UZ UTL_LineIndexStart(const UTL_LineIndex *index, UZ line)
+{
+  if (line >= index->count) return 0;
+  UZ segment = 0;
+  for (UZ low = 1, high = index->segment_count; low < high;)
+  {
+    UZ middle = low + (high - low) / 2;
+    if (index->segments[middle] <= line) segment = middle, low = middle + 1;
+    else high = middle;
+  }
+  return (UZ)(((U64)segment << 32) | index->starts[line]);
+}
+
+UTL_LinePosition UTL_LineIndexFind(const UTL_LineIndex *index, UZ offset)
+{
+  UTL_LinePosition position = { 0 };
+  if (!index->count) return position;
+  UZ segment = (UZ)Min((U64)offset >> 32, (U64)index->segment_count - 1);
+  UZ low = index->segments[segment];
+  UZ high = segment + 1 < index->segment_count ? index->segments[segment + 1] : index->count;
+  /* finds the first line of the segment starting after the offset, the one before it holds the offset */
+  for (U32 target = (U32)offset; low < high;)
+  {
+    UZ middle = low + (high - low) / 2;
+    if (index->starts[middle] <= target) low = middle + 1;
+    else high = middle;
+  }
+  position.line = low - 1;
+  position.column = offset - UTL_LineIndexStart(index, low - 1);
+  return position;
+}